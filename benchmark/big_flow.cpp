@@ -0,0 +1,37 @@
+#include <cib/cib.hpp>
+#include <flow/flow.hpp>
+
+#include <cstddef>
+#include <utility>
+
+#ifndef BIG_FLOW_SIZE
+#define BIG_FLOW_SIZE 100
+#endif
+
+constexpr static std::size_t flow_size = BIG_FLOW_SIZE;
+
+template <std::size_t Id> [[maybe_unused]] static int action_count = 0;
+
+template <std::size_t Id>
+constexpr static auto node =
+    flow::action("node"_sc, [] { ++action_count<Id>; });
+
+struct BigFlow : public flow::service<void, flow_size + 2, 4> {};
+
+template <std::size_t... Is>
+CIB_CONSTEVAL auto make_config(std::index_sequence<Is...>) {
+    return cib::config(cib::exports<BigFlow>,
+                       cib::extend<BigFlow>((node<Is> >> node<Is + 1>)...),
+                       cib::extend<BigFlow>((node<Is> >> node<Is + 2>)...));
+}
+
+struct BigConfig {
+    constexpr static auto config =
+        make_config(std::make_index_sequence<flow_size>{});
+};
+
+int main() {
+    cib::nexus<BigConfig> nexus{};
+    nexus.init();
+    nexus.service<BigFlow>();
+}
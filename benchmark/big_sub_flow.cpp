@@ -0,0 +1,53 @@
+#include <cib/cib.hpp>
+#include <flow/flow.hpp>
+
+#include <cstddef>
+#include <utility>
+
+#ifndef BIG_FLOW_SIZE
+#define BIG_FLOW_SIZE 100
+#endif
+
+// the same graph as big_flow.cpp, shipped as pre-sorted sub-flows of
+// sub_flow_size nodes each
+constexpr static std::size_t sub_flow_size = 10;
+constexpr static std::size_t num_sub_flows = BIG_FLOW_SIZE / sub_flow_size;
+
+template <std::size_t Id> [[maybe_unused]] static int action_count = 0;
+
+template <std::size_t Id>
+constexpr static auto node =
+    flow::action("node"_sc, [] { ++action_count<Id>; });
+
+template <std::size_t First, std::size_t... Is>
+constexpr auto segment_description(std::index_sequence<Is...>) {
+    return ((node<First + Is> >> node<First + Is + 1>) && ...) &&
+           ((node<First + Is> >> node<First + Is + 2>) && ...);
+}
+
+template <std::size_t K>
+constexpr static auto segment = flow::sub_flow("segment"_sc, [] {
+    return segment_description<K * sub_flow_size>(
+        std::make_index_sequence<sub_flow_size - 2>{});
+});
+
+struct BigFlow : public flow::service<void, num_sub_flows + 2, 4> {};
+
+template <std::size_t... Ks>
+CIB_CONSTEVAL auto make_config(std::index_sequence<Ks...>) {
+    return cib::config(
+        cib::exports<BigFlow>,
+        cib::extend<BigFlow>((segment<Ks> >> segment<Ks + 1>)...),
+        cib::extend<BigFlow>((segment<Ks> >> segment<Ks + 2>)...));
+}
+
+struct BigConfig {
+    constexpr static auto config =
+        make_config(std::make_index_sequence<num_sub_flows>{});
+};
+
+int main() {
+    cib::nexus<BigConfig> nexus{};
+    nexus.init();
+    nexus.service<BigFlow>();
+}
@@ -0,0 +1,62 @@
+#include <cib/cib.hpp>
+#include <flow/flow.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+
+#ifndef FLOW_RUNTIME_SIZE
+#define FLOW_RUNTIME_SIZE 200
+#endif
+
+#ifndef FLOW_RUNTIME_ITERATIONS
+#define FLOW_RUNTIME_ITERATIONS 100000
+#endif
+
+constexpr static std::size_t flow_size = FLOW_RUNTIME_SIZE;
+
+std::uint32_t counter{};
+
+template <std::size_t Id>
+constexpr static auto node =
+    flow::action("node"_sc, [] { counter = (counter * 3) + Id; });
+
+struct TableFlow : public flow::service<void, flow_size, 2> {};
+struct InlineFlow : public flow::inline_service<void, flow_size, 2> {};
+
+template <typename Flow, std::size_t... Is>
+CIB_CONSTEVAL auto extend_chain(std::index_sequence<Is...>) {
+    return cib::extend<Flow>((node<Is> >> node<Is + 1>)...);
+}
+
+struct RuntimeConfig {
+    constexpr static auto config = cib::config(
+        cib::exports<TableFlow, InlineFlow>,
+        extend_chain<TableFlow>(std::make_index_sequence<flow_size - 1>{}),
+        extend_chain<InlineFlow>(std::make_index_sequence<flow_size - 1>{}));
+};
+
+template <typename Flow> auto time_flow(char const *label) -> void {
+    auto const start = std::chrono::steady_clock::now();
+    for (auto i = 0; i < FLOW_RUNTIME_ITERATIONS; ++i) {
+        flow::run<Flow>();
+    }
+    auto const elapsed = std::chrono::steady_clock::now() - start;
+
+    auto const ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    std::cout << label << ": " << ns / FLOW_RUNTIME_ITERATIONS
+              << " ns per run of " << flow_size << " actions\n";
+}
+
+int main() {
+    cib::nexus<RuntimeConfig> nexus{};
+    nexus.init();
+
+    time_flow<TableFlow>("flow::impl       ");
+    time_flow<InlineFlow>("flow::inline_impl");
+
+    std::cout << "checksum: " << counter << '\n';
+}
@@ -0,0 +1,103 @@
+#include <msg/counted_match.hpp>
+#include <msg/handler.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#ifndef MSG_DISPATCH_CALLBACKS
+#define MSG_DISPATCH_CALLBACKS 64
+#endif
+
+// the number of consecutive messages that share an opcode
+#ifndef MSG_DISPATCH_RUN
+#define MSG_DISPATCH_RUN 1
+#endif
+
+#ifndef MSG_DISPATCH_ITERATIONS
+#define MSG_DISPATCH_ITERATIONS 100000
+#endif
+
+constexpr static std::size_t num_callbacks = MSG_DISPATCH_CALLBACKS;
+
+std::uint32_t checksum{};
+
+using opcode_field =
+    msg::field<decltype("opcode"_sc), 0, 31, 24, std::uint32_t>;
+using payload_field =
+    msg::field<decltype("payload"_sc), 0, 15, 0, std::uint32_t>;
+
+// counts how many times the payload is extracted
+using counted_payload = msg::counted_match<payload_field, 0x1234u>;
+
+using base_msg = msg::message_data<1>;
+
+template <std::uint32_t Opcode>
+using opcode_msg =
+    msg::message_base<decltype("opcode_msg"_sc), 1,
+                      opcode_field::WithRequired<Opcode>,
+                      payload_field::WithMatch<counted_payload>>;
+
+template <std::uint32_t Opcode>
+constexpr auto make_callback() {
+    return msg::callback<base_msg>(
+        "callback"_sc, match::always<true>,
+        [](opcode_msg<Opcode> const &m) {
+            checksum = (checksum * 3) + m.template get<payload_field>();
+        },
+        [](opcode_msg<Opcode> const &) { checksum += Opcode; });
+}
+
+template <std::size_t... Is>
+constexpr auto make_callbacks(std::index_sequence<Is...>) {
+    return cib::make_tuple(make_callback<static_cast<std::uint32_t>(Is)>()...);
+}
+
+int main() {
+    auto const callbacks =
+        make_callbacks(std::make_index_sequence<num_callbacks>{});
+    auto const handler =
+        msg::handler<std::remove_cvref_t<decltype(callbacks)>, base_msg>{
+            callbacks};
+
+    std::vector<base_msg> burst{};
+    for (auto i = 0; i < MSG_DISPATCH_ITERATIONS; ++i) {
+        auto const opcode =
+            static_cast<std::uint32_t>((i / MSG_DISPATCH_RUN) * 7) %
+            num_callbacks;
+        burst.push_back(base_msg{(opcode << 24u) | 0x1234u});
+    }
+
+    // dispatch through the interface, as msg::service users do
+    msg::handler_interface<base_msg> const *service = &handler;
+
+    auto start = std::chrono::steady_clock::now();
+    for (auto const &m : burst) {
+        service->handle(m);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    auto ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    std::cout << "msg::handler with " << num_callbacks
+              << " callbacks of 2 callables each\n"
+              << "  handle:       " << ns / MSG_DISPATCH_ITERATIONS
+              << " ns per message, "
+              << static_cast<double>(counted_payload::checks) / MSG_DISPATCH_ITERATIONS
+              << " field extractions per message\n";
+
+    counted_payload::checks = 0;
+    start = std::chrono::steady_clock::now();
+    service->handle_batch(burst);
+    elapsed = std::chrono::steady_clock::now() - start;
+
+    ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    std::cout << "  handle_batch: " << ns / MSG_DISPATCH_ITERATIONS
+              << " ns per message, "
+              << static_cast<double>(counted_payload::checks) / MSG_DISPATCH_ITERATIONS
+              << " field extractions per message\n"
+              << "checksum: " << checksum << '\n';
+}
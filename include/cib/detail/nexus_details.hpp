@@ -18,16 +18,40 @@ template <typename T>
 using get_service_from_tuple = typename std::remove_cvref_t<
     decltype(std::declval<T>()[index<0>])>::service_type;
 
+namespace detail {
+/**
+ * The builder a service starts from. A builder providing
+ * sized_for<ArgsTuples...>() is resized to fit the arguments of every
+ * extension of the service; any other builder is used as declared.
+ */
+template <typename Extensions>
+constexpr auto initial_builder(Extensions const &extensions) {
+    using first_t =
+        std::remove_cvref_t<decltype(std::declval<Extensions>()[index<0>])>;
+    using builder_t = std::remove_cvref_t<decltype(first_t::builder)>;
+
+    return extensions.apply([](auto const &...exts) {
+        if constexpr (requires {
+                          builder_t::template sized_for<std::remove_cvref_t<
+                              decltype(exts.args_tuple)>...>();
+                      }) {
+            return builder_t::template sized_for<
+                std::remove_cvref_t<decltype(exts.args_tuple)>...>();
+        } else {
+            return first_t::builder;
+        }
+    });
+}
+} // namespace detail
+
 template <typename Config>
 constexpr static auto initialized_builders = transform<extract_service_tag>(
     [](auto extensions) {
-        using namespace cib::tuple_literals;
-
         using exports_tuple = decltype(Config::config.exports_tuple());
         using service = get_service_from_tuple<decltype(extensions)>;
         static_assert(contains_type<exports_tuple, service>);
 
-        constexpr auto initial_builder = extensions[0_idx].builder;
+        auto const initial_builder = detail::initial_builder(extensions);
 
         auto built_service = extensions.fold_right(
             initial_builder, [](auto extension, auto outer_builder) {
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <flow/common.hpp>
+#include <flow/impl.hpp>
+#include <flow/milestone.hpp>
+#include <flow/reachability.hpp>
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace flow {
+/**
+ * flow::async_impl is a constant representation of a flow whose actions may
+ * take several calls to complete.
+ *
+ * Actions created with flow::async_action return status::NOT_DONE until
+ * their work has finished. Each step of a flow::async_impl keeps a count of
+ * the steps it depends on that are still pending, and is polled as soon as
+ * that count reaches zero. While one action waits on slow hardware or I/O,
+ * every step that does not depend on it keeps making progress, whatever its
+ * level.
+ *
+ * The flow never blocks. Each call to poll() makes one round of progress
+ * through a run recorded in a cursor: every ready step is polled once, and
+ * the steps it releases are polled in the same round. The flow itself holds
+ * no run state, so a constant flow can be driven from a main loop by passing
+ * its own cursor. A flow::async_service keeps its run in a cursor in static
+ * storage, the same way as flow::sliced_impl.
+ *
+ * @tparam Name
+ *      Name of flow as a compile-time string.
+ *
+ * @tparam NumSteps
+ *      The number of Milestones this flow::async_impl represents.
+ *
+ * @see flow::async_builder
+ */
+template <typename Name, std::size_t NumSteps>
+class async_impl {
+  public:
+    /**
+     * How far a run of the flow has progressed.
+     */
+    struct cursor {
+        std::array<std::size_t, NumSteps> pending_deps{};
+        std::array<bool, NumSteps> done{};
+        std::size_t remaining{};
+        bool started{};
+    };
+
+  private:
+    constexpr static bool tracingEnabled = detail::trace_milestones<Name>;
+
+    std::array<FunctionPtr, NumSteps> functionPtrs{};
+    std::array<PollPtr, NumSteps> pollPtrs{};
+    std::array<FunctionPtr, tracingEnabled ? NumSteps : 0> logPtrs{};
+    std::array<std::size_t, NumSteps> numDeps{};
+    reachability<NumSteps> dependents{};
+    std::size_t numLevels{};
+    build_status buildStatus;
+
+    auto step(std::size_t i) const -> status {
+        if (pollPtrs[i] != nullptr) {
+            return pollPtrs[i]();
+        }
+        functionPtrs[i]();
+        return status::DONE;
+    }
+
+    auto release(std::size_t i) const -> void {
+        if constexpr (tracingEnabled) {
+            logPtrs[i]();
+        }
+    }
+
+    auto start(cursor &c) const -> void {
+        detail::trace_flow<trace::event::FLOW_BEGIN, Name>();
+        c = cursor{};
+        c.pending_deps = numDeps;
+        c.remaining = NumSteps;
+        c.started = true;
+        for (auto i = std::size_t{}; i < NumSteps; i++) {
+            if (numDeps[i] == 0) {
+                release(i);
+            }
+        }
+    }
+
+  public:
+    constexpr static bool active = NumSteps > 0;
+
+    /**
+     * Create a new flow::async_impl of Milestones.
+     *
+     * Do not call this constructor directly, use flow::async_builder instead.
+     *
+     * @param newMilestones
+     *      Array of Milestones to execute in the flow, in sorted order.
+     *
+     * @param levels
+     *      The level of each Milestone in newMilestones.
+     *
+     * @param reach
+     *      Which of newMilestones depend on which others.
+     *
+     * @param buildStatus
+     *      flow::builder will report whether the flow::async_impl can be built
+     * successfully.
+     */
+    template <std::size_t Capacity>
+    constexpr async_impl(milestone_base *newMilestones,
+                         std::size_t const *levels,
+                         reachability<Capacity> const &reach,
+                         build_status newBuildStatus)
+        : buildStatus(newBuildStatus) {
+        for (auto i = std::size_t{}; i < NumSteps; i++) {
+            functionPtrs[i] = newMilestones[i].run;
+            pollPtrs[i] = newMilestones[i].poll;
+            if constexpr (tracingEnabled) {
+                logPtrs[i] = newMilestones[i].log_name;
+            }
+
+            if (i == 0 or levels[i] != levels[i - 1]) {
+                ++numLevels;
+            }
+            reach.for_each_dependent(i, [&](std::size_t j) {
+                dependents.add(i, j);
+                ++numDeps[j];
+            });
+        }
+    }
+
+    /**
+     * Make one round of progress through a run of the flow: poll every step
+     * whose dependencies are done, including the steps released by steps
+     * that finish in this round.
+     *
+     * @param c
+     *      Where the run has got to. A default-constructed cursor starts a
+     *      new run.
+     *
+     * @return
+     *      status::DONE once every step of the flow has completed, at which
+     *      point c is reset and the next call starts the flow again.
+     */
+    auto poll(cursor &c) const -> status {
+        if (not c.started) {
+            start(c);
+        }
+
+        for (auto i = std::size_t{}; i < NumSteps; i++) {
+            if (c.done[i] or c.pending_deps[i] != 0 or
+                step(i) == status::NOT_DONE) {
+                continue;
+            }
+            c.done[i] = true;
+            --c.remaining;
+            dependents.for_each_dependent(i, [&](std::size_t j) {
+                if (--c.pending_deps[j] == 0) {
+                    release(j);
+                }
+            });
+        }
+
+        if (c.remaining > 0) {
+            return status::NOT_DONE;
+        }
+        detail::trace_flow<trace::event::FLOW_END, Name>();
+        c = cursor{};
+        return status::DONE;
+    }
+
+    /**
+     * Make one round of progress through the run of a flow kept in static
+     * storage, so each such flow has exactly one run in progress at a time.
+     *
+     * @tparam Flow
+     *      The flow to poll. It must have static storage duration.
+     *
+     * @return
+     *      status::DONE once the run has completed.
+     */
+    template <async_impl const &Flow> static auto poll() -> status {
+        static cursor c{};
+        return Flow.poll(c);
+    }
+
+    /**
+     * Used by flow::async_service: each call makes one round of progress.
+     */
+    template <async_impl const &Flow> static auto run() -> void {
+        static_cast<void>(poll<Flow>());
+    }
+
+    /**
+     * @return
+     *      The number of levels in the flow.
+     */
+    [[nodiscard]] constexpr auto getNumLevels() const -> std::size_t {
+        return numLevels;
+    }
+
+    /**
+     * @return
+     *      Error status of the flow::async_impl building process.
+     */
+    [[nodiscard]] constexpr auto getBuildStatus() const -> build_status {
+        return buildStatus;
+    }
+};
+} // namespace flow
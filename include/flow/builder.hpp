@@ -1,10 +1,14 @@
 #pragma once
 
 #include <cib/builder_meta.hpp>
+#include <flow/async_impl.hpp>
 #include <flow/common.hpp>
 #include <flow/graph_builder.hpp>
 #include <flow/impl.hpp>
+#include <flow/inline_impl.hpp>
 #include <flow/milestone.hpp>
+#include <flow/parallel_impl.hpp>
+#include <flow/sliced_impl.hpp>
 
 #include <cstddef>
 
@@ -15,8 +19,8 @@ namespace flow {
  *      flow::builder.
  *
  * @tparam EdgeCapacity
- *      The maximum number of dependencies from one action or milestone to
- *      another.
+ *      The average number of dependencies from each action or milestone to
+ *      another: the flow can hold NodeCapacity * EdgeCapacity dependencies.
  *
  * @see flow::impl
  * @see flow::graph_builder
@@ -28,6 +32,91 @@ struct builder : graph_builder<milestone_base, Name, NodeCapacity, EdgeCapacity,
                                builder<Name, NodeCapacity, EdgeCapacity>> {
     template <typename N, std::size_t Capacity>
     using impl_t = flow::impl<N, Capacity>;
+
+    template <std::size_t Nodes, std::size_t Edges>
+    using rebind = builder<Name, Nodes, Edges>;
+};
+
+/**
+ * A flow::builder whose flows run each level of independent actions as one
+ * batch on an executor.
+ *
+ * @tparam Executor
+ *      The executor each level of the built flow is dispatched to.
+ *
+ * @see flow::parallel_impl
+ * @see flow::builder
+ */
+template <typename Name = void, executor Executor = serial_executor,
+          std::size_t NodeCapacity = 64, std::size_t EdgeCapacity = 16>
+struct parallel_builder
+    : graph_builder<
+          milestone_base, Name, NodeCapacity, EdgeCapacity,
+          parallel_builder<Name, Executor, NodeCapacity, EdgeCapacity>> {
+    template <typename N, std::size_t Capacity>
+    using impl_t = flow::parallel_impl<N, Capacity, Executor>;
+
+    template <std::size_t Nodes, std::size_t Edges>
+    using rebind = parallel_builder<Name, Executor, Nodes, Edges>;
+};
+
+/**
+ * A flow::builder whose flows are run as a single function with a direct call
+ * to every action, so that small actions can be inlined.
+ *
+ * @see flow::inline_impl
+ * @see flow::builder
+ */
+template <typename Name = void, std::size_t NodeCapacity = 64,
+          std::size_t EdgeCapacity = 16>
+struct inline_builder
+    : graph_builder<milestone_base, Name, NodeCapacity, EdgeCapacity,
+                    inline_builder<Name, NodeCapacity, EdgeCapacity>> {
+    template <typename N, std::size_t Capacity>
+    using impl_t = flow::inline_impl<N, Capacity>;
+
+    template <std::size_t Nodes, std::size_t Edges>
+    using rebind = inline_builder<Name, Nodes, Edges>;
+};
+
+/**
+ * A flow::builder whose flows poll actions that may take several calls to
+ * complete, letting the actions of a level overlap.
+ *
+ * @see flow::async_impl
+ * @see flow::async_action
+ * @see flow::builder
+ */
+template <typename Name = void, std::size_t NodeCapacity = 64,
+          std::size_t EdgeCapacity = 16>
+struct async_builder
+    : graph_builder<milestone_base, Name, NodeCapacity, EdgeCapacity,
+                    async_builder<Name, NodeCapacity, EdgeCapacity>> {
+    template <typename N, std::size_t Capacity>
+    using impl_t = flow::async_impl<N, Capacity>;
+
+    template <std::size_t Nodes, std::size_t Edges>
+    using rebind = async_builder<Name, Nodes, Edges>;
+};
+
+/**
+ * A flow::builder whose flows run at most StepsPerCall steps each time they
+ * are called, resuming where they stopped on the next call.
+ *
+ * @see flow::sliced_impl
+ * @see flow::builder
+ */
+template <typename Name = void, std::size_t StepsPerCall = 1,
+          std::size_t NodeCapacity = 64, std::size_t EdgeCapacity = 16>
+struct sliced_builder
+    : graph_builder<
+          milestone_base, Name, NodeCapacity, EdgeCapacity,
+          sliced_builder<Name, StepsPerCall, NodeCapacity, EdgeCapacity>> {
+    template <typename N, std::size_t Capacity>
+    using impl_t = flow::sliced_impl<N, Capacity, StepsPerCall>;
+
+    template <std::size_t Nodes, std::size_t Edges>
+    using rebind = sliced_builder<Name, StepsPerCall, Nodes, Edges>;
 };
 
 /**
@@ -43,4 +132,55 @@ template <typename Name = void, std::size_t NodeCapacity = 64,
           std::size_t EdgeCapacity = 16>
 struct service : cib::builder_meta<builder<Name, NodeCapacity, EdgeCapacity>,
                                    FunctionPtr> {};
+
+/**
+ * Extend this to create named flow services whose independent actions are
+ * dispatched to an executor.
+ *
+ * @see flow::parallel_builder
+ */
+template <typename Name = void, executor Executor = serial_executor,
+          std::size_t NodeCapacity = 64, std::size_t EdgeCapacity = 16>
+struct parallel_service
+    : cib::builder_meta<
+          parallel_builder<Name, Executor, NodeCapacity, EdgeCapacity>,
+          FunctionPtr> {};
+
+/**
+ * Extend this to create named flow services that are built into a single
+ * function with direct calls to every action.
+ *
+ * @see flow::inline_builder
+ */
+template <typename Name = void, std::size_t NodeCapacity = 64,
+          std::size_t EdgeCapacity = 16>
+struct inline_service
+    : cib::builder_meta<inline_builder<Name, NodeCapacity, EdgeCapacity>,
+                        FunctionPtr> {};
+
+/**
+ * Extend this to create named flow services whose asynchronous actions are
+ * polled alongside each other until the whole flow is done.
+ *
+ * @see flow::async_builder
+ */
+template <typename Name = void, std::size_t NodeCapacity = 64,
+          std::size_t EdgeCapacity = 16>
+struct async_service
+    : cib::builder_meta<async_builder<Name, NodeCapacity, EdgeCapacity>,
+                        FunctionPtr> {};
+
+/**
+ * Extend this to create named flow services that run a bounded slice of the
+ * flow each time the service is called, so that a long flow can share a
+ * cooperative main loop with latency-sensitive work.
+ *
+ * @see flow::sliced_builder
+ */
+template <typename Name = void, std::size_t StepsPerCall = 1,
+          std::size_t NodeCapacity = 64, std::size_t EdgeCapacity = 16>
+struct sliced_service
+    : cib::builder_meta<
+          sliced_builder<Name, StepsPerCall, NodeCapacity, EdgeCapacity>,
+          FunctionPtr> {};
 } // namespace flow
@@ -1,7 +1,29 @@
 #pragma once
 
+#include <flow/trace.hpp>
+#include <log/log.hpp>
+
+#include <type_traits>
+
 namespace flow {
+/**
+ * The result of one call to a step that may take several calls to complete.
+ */
+enum class status { NOT_DONE = 0, DONE = 1 };
+
 using FunctionPtr = auto (*)() -> void;
+using PredicatePtr = auto (*)() -> bool;
+using PollPtr = auto (*)() -> status;
+
+/**
+ * An executor runs a batch of mutually independent actions and returns only
+ * once all of them have completed.
+ *
+ * A thread pool or work-stealing scheduler can be plugged into
+ * flow::parallel_impl by providing a run() function with this signature.
+ */
+template <typename T>
+concept executor = requires(T &t, FunctionPtr const *ptr) { t.run(ptr, ptr); };
 
 /**
  * While a graph is being built, it is possible for a set of dependencies
@@ -9,4 +31,41 @@ using FunctionPtr = auto (*)() -> void;
  * enable this to be reported within the constexpr context.
  */
 enum class build_status { SUCCESS, HAS_CIRCULAR_DEPENDENCY };
+
+namespace detail {
+/**
+ * Whether the logging config discards everything it is given.
+ */
+template <typename... Ts>
+constexpr static bool null_logger =
+    std::is_same_v<std::remove_cvref_t<decltype(logging::config<Ts...>.logger)>,
+                   logging::null::logger>;
+
+/**
+ * Whether a flow traces each milestone as it runs. Only named flows are
+ * traced, and only when the logging config has a real logger that keeps TRACE
+ * messages or a flow::trace sink is configured; otherwise the per-milestone
+ * trace hooks are left out of the flow entirely.
+ */
+template <typename Name, typename... Ts>
+constexpr static bool trace_milestones =
+    not std::is_void_v<Name> and
+    ((not null_logger<Ts...> and
+      logging::is_enabled<logging::level::TRACE, Ts...>) or
+     trace::is_enabled<Ts...>);
+
+/**
+ * Mark the start or end of a named flow in the log and the trace sink.
+ */
+template <trace::event E, typename Name> auto trace_flow() -> void {
+    if constexpr (not std::is_void_v<Name>) {
+        if constexpr (E == trace::event::FLOW_BEGIN) {
+            CIB_TRACE("flow.start({})", Name{});
+        } else {
+            CIB_TRACE("flow.end({})", Name{});
+        }
+        trace::point<E, Name>();
+    }
+}
+} // namespace detail
 } // namespace flow
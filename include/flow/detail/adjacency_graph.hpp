@@ -0,0 +1,173 @@
+#pragma once
+
+#include <container/vector.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+namespace flow::detail {
+/**
+ * A fully constexpr directed graph stored as adjacency lists.
+ *
+ * Each node is assigned a dense index when it is first added. Edges are kept
+ * in a single pool shared by all nodes, with the successors of each node
+ * linked together in the order they were added. The in-degree of every node
+ * is kept up to date as edges are added. Looking up the index of a node is
+ * O(n), but once the graph is built every traversal works on indices alone,
+ * so a topological sort is O(V + E).
+ *
+ * Duplicate nodes and duplicate edges are ignored.
+ *
+ * @tparam Node The type of a node. Must be equality comparable.
+ * @tparam NodeCapacity The maximum number of nodes.
+ * @tparam EdgeCapacity The average number of edges out of each node: the
+ *         graph holds at most NodeCapacity * EdgeCapacity edges.
+ */
+template <typename Node, std::size_t NodeCapacity, std::size_t EdgeCapacity>
+class adjacency_graph {
+  public:
+    using index_t = std::size_t;
+
+  private:
+    /**
+     * An edge to node "to". Links are one-based so that zero means "none".
+     */
+    struct edge {
+        index_t to{};
+        index_t next{};
+    };
+
+    cib::vector<Node, NodeCapacity> nodes{};
+    cib::vector<edge, NodeCapacity * EdgeCapacity> edges{};
+    std::array<index_t, NodeCapacity> first_edge{};
+    std::array<index_t, NodeCapacity> last_edge{};
+    std::array<std::size_t, NodeCapacity> degrees{};
+
+  public:
+    /**
+     * The successors of one node, in the order their edges were added.
+     */
+    class successor_range {
+        edge const *pool{};
+        index_t head{};
+
+      public:
+        class iterator {
+            edge const *pool{};
+            index_t link{};
+
+          public:
+            constexpr iterator(edge const *p, index_t l) : pool{p}, link{l} {}
+
+            constexpr auto operator*() const -> index_t {
+                return pool[link - 1].to;
+            }
+
+            constexpr auto operator++() -> iterator & {
+                link = pool[link - 1].next;
+                return *this;
+            }
+
+            constexpr auto operator==(iterator const &other) const
+                -> bool = default;
+        };
+
+        constexpr successor_range(edge const *p, index_t h)
+            : pool{p}, head{h} {}
+
+        [[nodiscard]] constexpr auto begin() const -> iterator {
+            return {pool, head};
+        }
+
+        [[nodiscard]] constexpr auto end() const -> iterator {
+            return {pool, 0};
+        }
+    };
+
+    /**
+     * <b>Runtime complexity:</b> O(n)
+     *
+     * @return
+     *      The index of node, adding it to the graph if it is not present.
+     */
+    constexpr auto add_node(Node const &node) -> index_t {
+        auto const i = std::find(nodes.begin(), nodes.end(), node);
+        if (i != nodes.end()) {
+            return static_cast<index_t>(i - nodes.begin());
+        }
+        nodes.push_back(node);
+        return nodes.size() - 1;
+    }
+
+    /**
+     * <b>Runtime complexity:</b> O(n)
+     *
+     * @return
+     *      The index of node, or size() if it is not present.
+     */
+    [[nodiscard]] constexpr auto index_of(Node const &node) const -> index_t {
+        return static_cast<index_t>(
+            std::find(nodes.begin(), nodes.end(), node) - nodes.begin());
+    }
+
+    /**
+     * Add an edge from one node to another, adding either node if it is not
+     * present.
+     *
+     * <b>Runtime complexity:</b> O(n)
+     */
+    constexpr auto add_edge(Node const &from, Node const &to) -> void {
+        auto const src = add_node(from);
+        auto const dst = add_node(to);
+        for (auto const m : successors_of(src)) {
+            if (m == dst) {
+                return;
+            }
+        }
+
+        edges.push_back({dst, 0});
+        auto const link = edges.size();
+        if (last_edge[src] == 0) {
+            first_edge[src] = link;
+        } else {
+            edges[last_edge[src] - 1].next = link;
+        }
+        last_edge[src] = link;
+        ++degrees[dst];
+    }
+
+    /**
+     * <b>Runtime complexity:</b> O(1)
+     */
+    [[nodiscard]] constexpr auto size() const -> std::size_t {
+        return nodes.size();
+    }
+
+    /**
+     * <b>Runtime complexity:</b> O(1)
+     */
+    [[nodiscard]] constexpr auto node(index_t i) const -> Node const & {
+        return nodes[i];
+    }
+
+    /**
+     * <b>Runtime complexity:</b> O(1)
+     */
+    [[nodiscard]] constexpr auto successors_of(index_t i) const
+        -> successor_range {
+        return {edges.begin(), first_edge[i]};
+    }
+
+    /**
+     * <b>Runtime complexity:</b> O(1)
+     *
+     * @return
+     *      The number of edges leading into each node, indexed like the nodes.
+     */
+    [[nodiscard]] constexpr auto in_degrees() const
+        -> std::array<std::size_t, NodeCapacity> const & {
+        return degrees;
+    }
+};
+} // namespace flow::detail
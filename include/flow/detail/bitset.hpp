@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace flow::detail {
+/**
+ * A constexpr set of positions below Size, one bit per position, kept in
+ * 32-bit words.
+ *
+ * @tparam Size The number of positions.
+ */
+template <std::size_t Size> class bitset {
+    constexpr static auto word_bits = std::size_t{32};
+    std::array<std::uint32_t, (Size + word_bits - 1) / word_bits> words{};
+
+    [[nodiscard]] constexpr static auto bit(std::size_t i) -> std::uint32_t {
+        return std::uint32_t{1} << (i % word_bits);
+    }
+
+  public:
+    constexpr auto insert(std::size_t i) -> void {
+        words[i / word_bits] |= bit(i);
+    }
+
+    constexpr auto erase(std::size_t i) -> void {
+        words[i / word_bits] &= ~bit(i);
+    }
+
+    /**
+     * @return
+     *      A copy of this set with position i added.
+     */
+    [[nodiscard]] constexpr auto with(std::size_t i) const -> bitset {
+        bitset result{};
+        result |= *this;
+        result.insert(i);
+        return result;
+    }
+
+    [[nodiscard]] constexpr auto contains(std::size_t i) const -> bool {
+        return (words[i / word_bits] & bit(i)) != 0;
+    }
+
+    [[nodiscard]] constexpr auto empty() const -> bool {
+        for (auto const w : words) {
+            if (w != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @return
+     *      The number of positions in the set.
+     */
+    [[nodiscard]] constexpr auto size() const -> std::size_t {
+        auto count = std::size_t{};
+        for (auto const w : words) {
+            count += static_cast<std::size_t>(std::popcount(w));
+        }
+        return count;
+    }
+
+    [[nodiscard]] constexpr auto intersects(bitset const &other) const
+        -> bool {
+        for (auto i = std::size_t{}; i < words.size(); ++i) {
+            if ((words[i] & other.words[i]) != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    constexpr auto operator|=(bitset const &other) -> bitset & {
+        for (auto i = std::size_t{}; i < words.size(); ++i) {
+            words[i] |= other.words[i];
+        }
+        return *this;
+    }
+
+    /**
+     * Call f with every position in the set, in increasing order.
+     */
+    template <typename F> constexpr auto for_each(F &&f) const -> void {
+        for (auto w = std::size_t{}; w < words.size(); ++w) {
+            auto bits = words[w];
+            while (bits != 0) {
+                f((w * word_bits) +
+                  static_cast<std::size_t>(std::countr_zero(bits)));
+                bits &= bits - 1;
+            }
+        }
+    }
+};
+} // namespace flow::detail
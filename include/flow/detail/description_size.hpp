@@ -0,0 +1,43 @@
+#pragma once
+
+#include <flow/detail/dependency.hpp>
+#include <flow/detail/parallel.hpp>
+
+#include <cstddef>
+
+namespace flow::detail {
+/**
+ * Upper bounds on the size of the graph a flow description adds, worked out
+ * from its type alone. A node mentioned twice is counted twice, so the bounds
+ * are safe but not always tight.
+ */
+template <typename Node, typename T> struct description_size {
+    constexpr static std::size_t nodes = 1;
+    constexpr static std::size_t edges = 0;
+    constexpr static std::size_t heads = 1;
+    constexpr static std::size_t tails = 1;
+};
+
+template <typename Node, typename LhsT, typename RhsT>
+struct description_size<Node, dependency<Node, LhsT, RhsT>> {
+    using lhs = description_size<Node, LhsT>;
+    using rhs = description_size<Node, RhsT>;
+
+    constexpr static std::size_t nodes = lhs::nodes + rhs::nodes;
+    constexpr static std::size_t edges =
+        lhs::edges + rhs::edges + (lhs::tails * rhs::heads);
+    constexpr static std::size_t heads = lhs::heads;
+    constexpr static std::size_t tails = rhs::tails;
+};
+
+template <typename Node, typename LhsT, typename RhsT>
+struct description_size<Node, parallel<Node, LhsT, RhsT>> {
+    using lhs = description_size<Node, LhsT>;
+    using rhs = description_size<Node, RhsT>;
+
+    constexpr static std::size_t nodes = lhs::nodes + rhs::nodes;
+    constexpr static std::size_t edges = lhs::edges + rhs::edges;
+    constexpr static std::size_t heads = lhs::heads + rhs::heads;
+    constexpr static std::size_t tails = lhs::tails + rhs::tails;
+};
+} // namespace flow::detail
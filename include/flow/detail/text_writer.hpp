@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace flow::detail {
+/**
+ * Writes text at compile time. With a null output it only counts, so the
+ * same code can first size a buffer and then fill it.
+ */
+class text_writer {
+    char *out{};
+    std::size_t length{};
+
+  public:
+    constexpr explicit text_writer(char *o) : out{o} {}
+
+    constexpr auto put(char c) -> text_writer & {
+        if (out != nullptr) {
+            out[length] = c;
+        }
+        ++length;
+        return *this;
+    }
+
+    constexpr auto put(std::string_view text) -> text_writer & {
+        for (auto const c : text) {
+            put(c);
+        }
+        return *this;
+    }
+
+    constexpr auto put(std::size_t value) -> text_writer & {
+        auto divisor = std::size_t{1};
+        while (value / divisor >= 10) {
+            divisor *= 10;
+        }
+        for (; divisor > 0; divisor /= 10) {
+            put(static_cast<char>('0' + (value / divisor) % 10));
+        }
+        return *this;
+    }
+
+    /**
+     * Write text as the contents of a double-quoted DOT or JSON string.
+     */
+    constexpr auto put_quoted(std::string_view text) -> text_writer & {
+        put('"');
+        for (auto const c : text) {
+            if (c == '"' or c == '\\') {
+                put('\\');
+            }
+            put(c);
+        }
+        return put('"');
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t {
+        return length;
+    }
+};
+} // namespace flow::detail
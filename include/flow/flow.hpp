@@ -1,7 +1,13 @@
 #pragma once
 
+#include <flow/async_impl.hpp>
 #include <flow/builder.hpp>
 #include <flow/common.hpp>
+#include <flow/graph_export.hpp>
 #include <flow/impl.hpp>
+#include <flow/inline_impl.hpp>
 #include <flow/milestone.hpp>
+#include <flow/parallel_impl.hpp>
 #include <flow/run.hpp>
+#include <flow/sliced_impl.hpp>
+#include <flow/sub_flow.hpp>
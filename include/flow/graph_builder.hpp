@@ -1,12 +1,21 @@
 #pragma once
 
-#include <container/constexpr_multimap.hpp>
+#include <cib/tuple.hpp>
+#include <container/vector.hpp>
 #include <flow/common.hpp>
+#include <flow/detail/adjacency_graph.hpp>
+#include <flow/detail/description_size.hpp>
+#include <flow/detail/text_writer.hpp>
+#include <flow/levelized_graph.hpp>
+#include <flow/reachability.hpp>
+#include <flow/residual_graph.hpp>
 
 #include <algorithm>
 #include <array>
 #include <concepts>
 #include <cstddef>
+#include <string_view>
+#include <type_traits>
 
 namespace flow {
 namespace detail {
@@ -27,59 +36,121 @@ concept walkable = std::same_as<T, Node> or
  * @tparam Node The type of a flow node.
  * @tparam Name The name of this builder.
  * @tparam NodeCapacity The maximum number of nodes that can be added.
- * @tparam EdgeCapacity The maximum number of edges between one node and
- *         another.
- * @tparam Derived The class that uses graph_builder with CRTP.
+ * @tparam EdgeCapacity The average number of edges out of each node: at most
+ *         NodeCapacity * EdgeCapacity edges can be added.
+ * @tparam Derived The class that uses graph_builder with CRTP. It provides
+ *         impl_t, the flow type to build, and rebind, the same builder with
+ *         other capacities.
  */
 template <typename Node, typename NameT, std::size_t NodeCapacity,
           std::size_t EdgeCapacity, typename Derived>
 class graph_builder {
-    using graph_t =
-        cib::constexpr_multimap<Node, Node, NodeCapacity, EdgeCapacity>;
+    using graph_t = detail::adjacency_graph<Node, NodeCapacity, EdgeCapacity>;
+    using index_t = typename graph_t::index_t;
     graph_t graph{};
 
-    [[nodiscard]] constexpr static auto is_source_of(Node node,
-                                                     graph_t const &g) -> bool {
-        return std::find_if(g.begin(), g.end(), [&](auto const &entry) {
-                   return entry.value.contains(node);
-               }) == g.end();
-    }
-
-    [[nodiscard]] constexpr auto get_sources() const
-        -> cib::constexpr_set<Node, NodeCapacity> {
-        cib::constexpr_set<Node, NodeCapacity> s;
-        for (auto const &entry : graph) {
-            s.add(entry.key);
-        }
-        for (auto const &entry : graph) {
-            for (auto const &dst : entry.value) {
-                s.remove(dst.key);
-            }
-        }
-        return s;
-    }
-
-    constexpr auto insert(Node const &node) -> void { graph.put(node); }
+    constexpr auto insert(Node const &node) -> void { graph.add_node(node); }
 
     template <detail::walkable<Node> T>
     constexpr auto insert(T const &t) -> void {
         t.walk([&](Node lhs, Node rhs) {
             if (rhs == Node{}) {
-                graph.put(lhs);
+                graph.add_node(lhs);
             } else {
-                graph.put(lhs, rhs);
+                graph.add_edge(lhs, rhs);
             }
         });
     }
 
+    /**
+     * Milestones order the flow but do no work. Unless they are traced, they
+     * are left out of a built flow once it has been sorted.
+     */
+    [[nodiscard]] constexpr static auto is_dead(Node const &node) -> bool {
+        if constexpr (requires { node.is_milestone(); }) {
+            return not detail::trace_milestones<NameT> and node.is_milestone();
+        } else {
+            return false;
+        }
+    }
+
+    [[nodiscard]] constexpr static auto guard_of(Node const &node) {
+        if constexpr (requires { node.predicate(); }) {
+            return node.predicate();
+        } else {
+            return nullptr;
+        }
+    }
+
+    [[nodiscard]] constexpr static auto name_of(Node const &node)
+        -> std::string_view {
+        if constexpr (requires { node.get_name(); }) {
+            if (not node.get_name().empty()) {
+                return node.get_name();
+            }
+        }
+        return "<unnamed>";
+    }
+
+    /**
+     * Spell out the cycle of a residual graph as "a >> b >> a", writing it
+     * to out unless out is null.
+     *
+     * @return The length of the text.
+     */
+    constexpr static auto
+    write_cycle(residual_graph<Node, NodeCapacity, EdgeCapacity> const &r,
+                char *out) -> std::size_t {
+        detail::text_writer text{out};
+        auto const &cycle = r.cycle();
+        for (auto const &node : cycle) {
+            text.put(name_of(node)).put(" >> ");
+        }
+        if (not cycle.empty()) {
+            text.put(name_of(cycle[0]));
+        }
+        return text.size();
+    }
+
+    template <typename BuilderValue>
+    constexpr static auto cycle_text = [] {
+        constexpr auto r = BuilderValue::value.residual();
+        detail::fixed_text<write_cycle(r, nullptr) + 1> text{};
+        write_cycle(r, text.value);
+        return text;
+    }();
+
+    template <typename ArgsTuple> struct args_size;
+
+    template <typename... Args> struct args_size<cib::tuple<Args...>> {
+        constexpr static std::size_t nodes =
+            (detail::description_size<Node, Args>::nodes + ... + 0);
+        constexpr static std::size_t edges =
+            (detail::description_size<Node, Args>::edges + ... + 0);
+    };
+
+    template <typename BuilderValue,
+              template <typename, std::size_t> typename Output>
+    constexpr static auto built =
+        BuilderValue::value
+            .template topo_sort<Output, BuilderValue::value.num_steps()>();
+
     template <typename BuilderValue,
               template <typename, std::size_t> typename Output>
     static auto run_impl() -> void {
-        constexpr auto builder = BuilderValue::value;
-        constexpr auto size = builder.size();
-        constexpr auto built = builder.template topo_sort<Output, size>();
-        static_assert(built.getBuildStatus() == flow::build_status::SUCCESS);
-        built();
+        constexpr auto const &flow = built<BuilderValue, Output>;
+        if constexpr (flow.getBuildStatus() != build_status::SUCCESS) {
+            report_cycle<BuilderValue>();
+        }
+
+        using flow_t = std::remove_cvref_t<decltype(flow)>;
+        if constexpr (requires {
+                          flow_t::template run<built<BuilderValue, Output>>();
+                      }) {
+            flow_t::template run<built<BuilderValue, Output>>();
+        } else {
+            flow();
+        }
     }
 
   public:
@@ -117,61 +188,437 @@ class graph_builder {
         return static_cast<Derived &>(*this);
     }
 
+    /**
+     * Sort the graph one level at a time.
+     *
+     * A node's level (its depth) is the length of the longest chain of
+     * dependencies leading to it, so nodes that share a level never depend on
+     * each other.
+     *
+     * @return A flow::levelized_graph holding the sorted nodes, their depths,
+     * the width of each level and the critical path.
+     */
+    [[nodiscard]] constexpr auto levelize() const
+        -> levelized_graph<Node, NodeCapacity> {
+        levelized_graph<Node, NodeCapacity> result{};
+        auto in_degrees = graph.in_degrees();
+        std::array<index_t, NodeCapacity> longest_pred{};
+        std::array<index_t, NodeCapacity> ordered{};
+        std::size_t wave_begin{};
+        std::size_t wave_end{};
+        std::size_t num_sorted{};
+
+        for (auto i = index_t{}; i < graph.size(); ++i) {
+            if (in_degrees[i] == 0) {
+                ordered[wave_end++] = i;
+            }
+        }
+
+        for (auto level = std::size_t{}; wave_begin != wave_end; ++level) {
+            result.widths.push_back(wave_end - wave_begin);
+            num_sorted = wave_end;
+
+            for (auto w = wave_begin; w < wave_end; ++w) {
+                auto const n = ordered[w];
+                result.depths.push_back(level);
+                result.nodes.push_back(graph.node(n));
+
+                for (auto const m : graph.successors_of(n)) {
+                    if (--in_degrees[m] == 0) {
+                        ordered[num_sorted++] = m;
+                        longest_pred[m] = n;
+                    }
+                }
+            }
+
+            wave_begin = wave_end;
+            wave_end = num_sorted;
+        }
+
+        if (num_sorted > 0) {
+            auto n = ordered[num_sorted - 1];
+            result.path.push_back(graph.node(n));
+            for (auto depth = result.widths.size() - 1; depth > 0; --depth) {
+                n = longest_pred[n];
+                result.path.push_back(graph.node(n));
+            }
+            std::reverse(result.path.begin(), result.path.end());
+        }
+
+        result.buildStatus = num_sorted == graph.size()
+                                 ? build_status::SUCCESS
+                                 : build_status::HAS_CIRCULAR_DEPENDENCY;
+        return result;
+    }
+
+    /**
+     * Find the part of the graph that cannot be sorted because of circular
+     * dependencies.
+     *
+     * Nodes are peeled off the graph from both ends: first those whose
+     * dependencies can all be sorted, then those that no remaining node
+     * depends on. Every node left over lies on a cycle or on a path between
+     * cycles, so following dependencies from any of them leads back round to
+     * a node already seen.
+     *
+     * @return A flow::residual_graph with the remaining nodes and edges and
+     * one of the cycles. It is empty when the graph can be sorted.
+     */
+    [[nodiscard]] constexpr auto residual() const
+        -> residual_graph<Node, NodeCapacity, EdgeCapacity> {
+        residual_graph<Node, NodeCapacity, EdgeCapacity> result{};
+        auto in_degrees = graph.in_degrees();
+        std::array<bool, NodeCapacity> removed{};
+        std::array<index_t, NodeCapacity> ready{};
+        std::size_t num_ready{};
+
+        for (auto i = index_t{}; i < graph.size(); ++i) {
+            if (in_degrees[i] == 0) {
+                ready[num_ready++] = i;
+            }
+        }
+        for (auto r = std::size_t{}; r < num_ready; ++r) {
+            auto const n = ready[r];
+            removed[n] = true;
+            for (auto const m : graph.successors_of(n)) {
+                if (--in_degrees[m] == 0) {
+                    ready[num_ready++] = m;
+                }
+            }
+        }
+
+        auto const next_of = [&](index_t n) -> index_t {
+            for (auto const m : graph.successors_of(n)) {
+                if (not removed[m]) {
+                    return m;
+                }
+            }
+            return graph.size();
+        };
+
+        for (auto changed = true; changed;) {
+            changed = false;
+            for (auto i = index_t{}; i < graph.size(); ++i) {
+                if (not removed[i] and next_of(i) == graph.size()) {
+                    removed[i] = true;
+                    changed = true;
+                }
+            }
+        }
+
+        std::array<std::size_t, NodeCapacity> position{};
+        for (auto i = index_t{}; i < graph.size(); ++i) {
+            if (not removed[i]) {
+                position[i] = result.nodes.size();
+                result.nodes.push_back(graph.node(i));
+            }
+        }
+        for (auto i = index_t{}; i < graph.size(); ++i) {
+            if (removed[i]) {
+                continue;
+            }
+            for (auto const m : graph.successors_of(i)) {
+                if (not removed[m]) {
+                    result.edges.push_back({position[i], position[m]});
+                }
+            }
+        }
+
+        if (not result.nodes.empty()) {
+            std::array<std::size_t, NodeCapacity> visited_at{};
+            cib::vector<index_t, NodeCapacity> walk{};
+            auto n = index_t{};
+            while (removed[n]) {
+                ++n;
+            }
+            while (visited_at[n] == 0) {
+                walk.push_back(n);
+                visited_at[n] = walk.size();
+                n = next_of(n);
+            }
+            for (auto i = visited_at[n] - 1; i < walk.size(); ++i) {
+                result.loop.push_back(graph.node(walk[i]));
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Fail to compile with the names of the nodes on a cycle of the builder
+     * held by BuilderValue::value. Call this when a flow could not be built
+     * because of a circular dependency.
+     *
+     * @see flow::circular_dependency
+     */
+    template <typename BuilderValue> static auto report_cycle() -> void {
+        static_cast<void>(
+            sizeof(circular_dependency<cycle_text<BuilderValue>>));
+    }
+
+    /**
+     * Write the graph in Graphviz DOT format, one statement per node and per
+     * edge. Nodes are labelled with their names and milestones are drawn as
+     * diamonds.
+     *
+     * @param out Where to write the text, or null to only measure it.
+     *
+     * @return The length of the text.
+     *
+     * @see flow::dot_graph
+     */
+    constexpr auto write_dot(char *out) const -> std::size_t {
+        detail::text_writer text{out};
+        text.put("digraph ");
+        if constexpr (not std::is_void_v<NameT>) {
+            text.put_quoted(NameT::value).put(' ');
+        }
+        text.put("{\n");
+
+        for (auto i = index_t{}; i < graph.size(); ++i) {
+            auto const &node = graph.node(i);
+            text.put("    n").put(i).put(" [label=").put_quoted(name_of(node));
+            if constexpr (requires { node.is_milestone(); }) {
+                if (node.is_milestone()) {
+                    text.put(", shape=diamond");
+                }
+            }
+            text.put("];\n");
+        }
+        for (auto i = index_t{}; i < graph.size(); ++i) {
+            for (auto const m : graph.successors_of(i)) {
+                text.put("    n").put(i).put(" -> n").put(m).put(";\n");
+            }
+        }
+        return text.put("}\n").size();
+    }
+
+    /**
+     * Write the graph as JSON:
+     *
+     * <pre>
+     *   {"name": ..., "nodes": [{"id": 0, "name": "a", "level": 0}, ...],
+     *    "edges": [[0, 1], ...]}
+     * </pre>
+     *
+     * Edges refer to nodes by id. Each node's level is its depth as given by
+     * levelize(); it is left out if the graph has a circular dependency.
+     *
+     * @param out Where to write the text, or null to only measure it.
+     *
+     * @return The length of the text.
+     *
+     * @see flow::json_graph
+     */
+    constexpr auto write_json(char *out) const -> std::size_t {
+        auto const levels = levelize();
+        auto const sortable = levels.getBuildStatus() == build_status::SUCCESS;
+
+        detail::text_writer text{out};
+        text.put("{\"name\": ");
+        if constexpr (std::is_void_v<NameT>) {
+            text.put("null");
+        } else {
+            text.put_quoted(NameT::value);
+        }
+
+        text.put(", \"nodes\": [");
+        for (auto i = index_t{}; i < graph.size(); ++i) {
+            auto const &node = graph.node(i);
+            text.put(i == 0 ? "" : ", ").put("{\"id\": ").put(i);
+            text.put(", \"name\": ").put_quoted(name_of(node));
+            if (sortable) {
+                text.put(", \"level\": ").put(levels.depth_of(node));
+            }
+            text.put('}');
+        }
+
+        text.put("], \"edges\": [");
+        auto first = true;
+        for (auto i = index_t{}; i < graph.size(); ++i) {
+            for (auto const m : graph.successors_of(i)) {
+                text.put(first ? "[" : ", [").put(i).put(", ").put(m);
+                text.put(']');
+                first = false;
+            }
+        }
+        return text.put("]}\n").size();
+    }
+
+    /**
+     * Work out which of the given nodes depend on which others, following
+     * every path through the graph, including paths through nodes that are
+     * not among them. Each node's descendants are the union of its
+     * successors and their descendants, so visiting the nodes in reverse
+     * topological order finds them all, a row of bits at a time.
+     */
+    [[nodiscard]] constexpr auto
+    reachability_of(cib::vector<Node, NodeCapacity> const &nodes) const
+        -> reachability<NodeCapacity> {
+        auto in_degrees = graph.in_degrees();
+        cib::vector<index_t, NodeCapacity> order{};
+        for (auto i = index_t{}; i < graph.size(); ++i) {
+            if (in_degrees[i] == 0) {
+                order.push_back(i);
+            }
+        }
+        for (auto i = std::size_t{}; i < order.size(); ++i) {
+            for (auto const m : graph.successors_of(order[i])) {
+                if (--in_degrees[m] == 0) {
+                    order.push_back(m);
+                }
+            }
+        }
+
+        reachability<NodeCapacity> below{};
+        for (auto i = order.size(); i > 0; --i) {
+            auto const n = order[i - 1];
+            for (auto const m : graph.successors_of(n)) {
+                below.add_through(n, m);
+            }
+        }
+
+        std::array<index_t, NodeCapacity> index{};
+        std::array<std::size_t, NodeCapacity> position{};
+        position.fill(NodeCapacity);
+        for (auto i = std::size_t{}; i < nodes.size(); ++i) {
+            index[i] = graph.index_of(nodes[i]);
+            position[index[i]] = i;
+        }
+
+        reachability<NodeCapacity> result{};
+        for (auto i = std::size_t{}; i < nodes.size(); ++i) {
+            below.for_each_dependent(index[i], [&](index_t m) {
+                if (position[m] != NodeCapacity) {
+                    result.add(i, position[m]);
+                }
+            });
+        }
+        return result;
+    }
+
     /**
      * Create an object combining all the specifications previously given to the
      * builder.
      *
+     * Nodes are emitted in the order given by levelize(), leaving out
+     * milestones that do no work. Their ordering constraints still hold,
+     * because the nodes around them keep their sorted positions and levels. If
+     * the output type is constructible from the per-node levels as well as
+     * the nodes, it receives them. If it is also constructible from a
+     * flow::reachability, it receives which of the emitted nodes depend on
+     * which others.
+     *
+     * Within each level, nodes that share a guard are emitted next to each
+     * other, starting with the guard of the node before the level. A guard
+     * can then be checked once for a whole segment of the flow.
+     *
      * @tparam Output The (template) type of the output object.
      * @tparam Capacity The maximum number of nodes the object will contain.
      * This can be optimized to the minimal value if the builder is assigned to
-     * a constexpr variable. The size() method can then be used as this template
-     * parameter.
+     * a constexpr variable. The num_steps() method can then be used as this
+     * template parameter.
      *
      * @return An object with all dependencies and requirements resolved.
      */
     template <template <typename, std::size_t> typename Output,
               std::size_t Capacity>
     [[nodiscard]] constexpr auto topo_sort() const -> Output<Name, Capacity> {
-        graph_t g = graph;
-        std::array<Node, NodeCapacity> ordered_list{};
-        std::size_t list_size{};
-
-        auto sources = get_sources();
-        while (not sources.empty()) {
-            auto n = sources.pop();
-            ordered_list[list_size++] = n;
-
-            if (g.contains(n)) {
-                auto ms = g.get(n);
-                if (ms.empty()) {
-                    g.remove(n);
-                } else {
-                    for (auto entry : ms) {
-                        auto m = entry.key;
-                        g.remove(n, m);
-                        if (is_source_of(m, g)) {
-                            sources.add(m);
-                        }
+        auto const sorted = levelize();
+        cib::vector<Node, NodeCapacity> nodes{};
+        cib::vector<std::size_t, NodeCapacity> depths{};
+        std::array<bool, NodeCapacity> emitted{};
+
+        auto level_begin = std::size_t{};
+        while (level_begin < sorted.size()) {
+            auto level_end = level_begin;
+            while (level_end < sorted.size() and
+                   sorted.depths[level_end] == sorted.depths[level_begin]) {
+                ++level_end;
+            }
+
+            auto const emit_group = [&](auto guard) {
+                for (auto i = level_begin; i < level_end; ++i) {
+                    auto const &node = sorted.nodes[i];
+                    if (emitted[i] or guard_of(node) != guard) {
+                        continue;
+                    }
+                    emitted[i] = true;
+                    if (not is_dead(node)) {
+                        nodes.push_back(node);
+                        depths.push_back(sorted.depths[i]);
                     }
                 }
+            };
+
+            if (nodes.size() > 0) {
+                emit_group(guard_of(nodes[nodes.size() - 1]));
+            }
+            for (auto i = level_begin; i < level_end; ++i) {
+                if (not emitted[i]) {
+                    emit_group(guard_of(sorted.nodes[i]));
+                }
             }
+            level_begin = level_end;
         }
 
-        auto buildStatus = g.empty() ? build_status::SUCCESS
-                                     : build_status::HAS_CIRCULAR_DEPENDENCY;
-        return Output<Name, Capacity>(ordered_list.data(), buildStatus);
+        if constexpr (std::is_constructible_v<
+                          Output<Name, Capacity>, Node *, std::size_t const *,
+                          reachability<NodeCapacity> const &, build_status>) {
+            return Output<Name, Capacity>(nodes.begin(), depths.begin(),
+                                          reachability_of(nodes),
+                                          sorted.getBuildStatus());
+        } else if constexpr (std::is_constructible_v<Output<Name, Capacity>,
+                                                     Node *,
+                                                     std::size_t const *,
+                                                     build_status>) {
+            return Output<Name, Capacity>(nodes.begin(), depths.begin(),
+                                          sorted.getBuildStatus());
+        } else {
+            return Output<Name, Capacity>(nodes.begin(),
+                                          sorted.getBuildStatus());
+        }
     }
 
     /**
      * @return The capacity necessary to fit the built graph.
      */
     [[nodiscard]] constexpr auto size() const -> std::size_t {
-        cib::constexpr_set<Node, NodeCapacity> all_nodes{};
-        for (auto entry : graph) {
-            all_nodes.add(entry.key);
-            all_nodes.add_all(entry.value);
+        return graph.size();
+    }
+
+    /**
+     * @return The number of steps in the built flow: the nodes of the graph
+     * less the milestones that topo_sort() leaves out.
+     */
+    [[nodiscard]] constexpr auto num_steps() const -> std::size_t {
+        auto steps = std::size_t{};
+        for (auto i = index_t{}; i < graph.size(); ++i) {
+            if (not is_dead(graph.node(i))) {
+                ++steps;
+            }
         }
-        return all_nodes.size();
+        return steps;
+    }
+
+    /**
+     * Used by cib::nexus to size a builder for the extensions it will be
+     * given, instead of relying on fixed capacities.
+     *
+     * @tparam ArgsTuples The cib::tuple of arguments of each extension.
+     *
+     * @return An empty builder whose capacities fit every node and edge those
+     * extensions can add.
+     */
+    template <typename... ArgsTuples>
+    [[nodiscard]] constexpr static auto sized_for() {
+        constexpr auto nodes = (args_size<ArgsTuples>::nodes + ... + 0);
+        constexpr auto edges = (args_size<ArgsTuples>::edges + ... + 0);
+        constexpr auto node_capacity = std::max(nodes, std::size_t{1});
+        constexpr auto edges_per_node =
+            std::max((edges + node_capacity - 1) / node_capacity,
+                     std::size_t{1});
+        return typename Derived::template rebind<node_capacity,
+                                                 edges_per_node>{};
     }
 
     template <typename BuilderValue>
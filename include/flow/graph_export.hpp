@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace flow {
+namespace detail {
+struct dot_format {
+    template <typename Builder>
+    constexpr static auto write(Builder const &builder, char *out)
+        -> std::size_t {
+        return builder.write_dot(out);
+    }
+};
+
+struct json_format {
+    template <typename Builder>
+    constexpr static auto write(Builder const &builder, char *out)
+        -> std::size_t {
+        return builder.write_json(out);
+    }
+};
+
+template <auto const &Builder, typename Format>
+constexpr static auto exported_text = [] {
+    std::array<char, Format::write(Builder, nullptr)> text{};
+    Format::write(Builder, text.data());
+    return text;
+}();
+
+template <auto const &Builder, typename Format>
+constexpr static auto exported_view = std::string_view{
+    exported_text<Builder, Format>.data(),
+    exported_text<Builder, Format>.size()};
+} // namespace detail
+
+/**
+ * The graph of a flow builder in Graphviz DOT format, produced at compile
+ * time.
+ *
+ * @tparam Builder
+ *      A flow builder with static storage duration, for example
+ *      cib::initialized<Config, MyFlow>::value for a service of a nexus.
+ *
+ * @see flow::graph_builder::write_dot
+ */
+template <auto const &Builder>
+constexpr static std::string_view dot_graph =
+    detail::exported_view<Builder, detail::dot_format>;
+
+/**
+ * The graph of a flow builder as JSON, produced at compile time. Each node
+ * is listed with its level, so the nodes that could run in parallel are easy
+ * to pick out.
+ *
+ * @tparam Builder
+ *      A flow builder with static storage duration, for example
+ *      cib::initialized<Config, MyFlow>::value for a service of a nexus.
+ *
+ * @see flow::graph_builder::write_json
+ */
+template <auto const &Builder>
+constexpr static std::string_view json_graph =
+    detail::exported_view<Builder, detail::json_format>;
+} // namespace flow
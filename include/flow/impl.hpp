@@ -2,9 +2,12 @@
 
 #include <flow/common.hpp>
 #include <flow/milestone.hpp>
+#include <flow/profiling.hpp>
 
 #include <array>
+#include <chrono>
 #include <cstddef>
+#include <string_view>
 #include <type_traits>
 
 namespace flow {
@@ -22,6 +25,14 @@ struct interface {
  * components can then add their own actions and milestones to a flow::impl
  * relative to other actions and milestones.
  *
+ * Steps created with flow::action_if are split into segments of consecutive
+ * steps sharing a guard; each guard is checked once per segment.
+ *
+ * Besides running to completion, a flow::impl can be run a slice at a time
+ * with run_slice(), so that a long flow does not hold up a cooperative main
+ * loop. A cursor records where the flow stopped and the next slice resumes
+ * from there.
+ *
  * @tparam Name
  *      Name of flow as a compile-time string.
  *
@@ -32,22 +43,87 @@ struct interface {
  */
 template <typename Name, std::size_t NumSteps> class impl : public interface {
   private:
-    constexpr static bool loggingEnabled = not std::is_void_v<Name>;
+    constexpr static bool tracingEnabled = detail::trace_milestones<Name>;
+    constexpr static bool profilingEnabled = profiling::is_enabled<Name>;
 
     constexpr static auto capacity = [] {
-        if constexpr (loggingEnabled) {
+        if constexpr (tracingEnabled) {
             return NumSteps * 2;
         } else {
             return NumSteps;
         }
     }();
 
+    /**
+     * A contiguous run of steps sharing one guard, ending before step last.
+     */
+    struct segment {
+        PredicatePtr guard{};
+        std::size_t last{};
+    };
+
     std::array<FunctionPtr, capacity> functionPtrs{};
+    std::array<segment, NumSteps> segments{};
+    std::size_t numSegments{};
+    std::array<std::string_view, profilingEnabled ? NumSteps : 0> names{};
+    std::array<profiling::log_step_ptr, profilingEnabled ? NumSteps : 0>
+        profileLogPtrs{};
     build_status buildStatus;
 
+    constexpr static auto stepSize = NumSteps == 0 ? 0 : capacity / NumSteps;
+
+    auto run_steps(std::size_t first, std::size_t last) const -> void {
+        for (auto i = first * stepSize; i < last * stepSize; i++) {
+            functionPtrs[i]();
+        }
+    }
+
+    auto run_range(std::size_t first, std::size_t last) const -> void {
+        if constexpr (profilingEnabled) {
+            run_profiled(first, last);
+        } else {
+            run_steps(first, last);
+        }
+    }
+
+    auto start() const -> void {
+        detail::trace_flow<trace::event::FLOW_BEGIN, Name>();
+
+        if constexpr (profilingEnabled) {
+            auto &stats = profiling::storage<Name, NumSteps>;
+            profiling::results<Name> = {stats.data(), names.data(),
+                                        profileLogPtrs.data(), NumSteps};
+        }
+    }
+
+    auto run_profiled(std::size_t first, std::size_t last) const -> void {
+        using clock = profiling::clock_type<Name>;
+        auto &stats = profiling::storage<Name, NumSteps>;
+
+        for (auto i = first; i < last; i++) {
+            auto const step = functionPtrs.data() + (i * stepSize);
+            for (auto j = std::size_t{}; j < stepSize - 1; j++) {
+                step[j]();
+            }
+
+            auto const start = clock::now();
+            step[stepSize - 1]();
+            stats[i].add(clock::now() - start);
+        }
+    }
+
   public:
     constexpr static bool active = capacity > 0;
 
+    /**
+     * How far a sliced run of the flow has progressed.
+     */
+    struct cursor {
+        std::size_t step{};
+        std::size_t segment{};
+        bool started{};
+    };
+
     /**
      * Create a new flow::impl of Milestones.
      *
@@ -66,14 +142,29 @@ template <typename Name, std::size_t NumSteps> class impl : public interface {
      */
     constexpr impl(milestone_base *newMilestones, build_status newBuildStatus)
         : functionPtrs(), buildStatus(newBuildStatus) {
-        if constexpr (loggingEnabled) {
+        if constexpr (tracingEnabled) {
             for (auto i = std::size_t{}; i < NumSteps; i++) {
                 functionPtrs[(i * 2)] = newMilestones[i].log_name;
-                functionPtrs[(i * 2) + 1] = newMilestones[i].run;
+                functionPtrs[(i * 2) + 1] = newMilestones[i].body;
             }
         } else {
             for (auto i = std::size_t{}; i < NumSteps; i++) {
-                functionPtrs[i] = newMilestones[i].run;
+                functionPtrs[i] = newMilestones[i].body;
+            }
+        }
+
+        for (auto i = std::size_t{}; i < NumSteps; i++) {
+            auto const guard = newMilestones[i].guard;
+            if (numSegments == 0 or segments[numSegments - 1].guard != guard) {
+                segments[numSegments++].guard = guard;
+            }
+            segments[numSegments - 1].last = i + 1;
+        }
+
+        if constexpr (profilingEnabled) {
+            for (auto i = std::size_t{}; i < NumSteps; i++) {
+                names[i] = newMilestones[i].name;
+                profileLogPtrs[i] = newMilestones[i].log_profile;
             }
         }
     }
@@ -82,17 +173,99 @@ template <typename Name, std::size_t NumSteps> class impl : public interface {
      * Execute the entire flow in order.
      */
     auto operator()() const -> void final {
-        if constexpr (loggingEnabled) {
-            CIB_TRACE("flow.start({})", Name{});
+        start();
+
+        auto first = std::size_t{};
+        for (auto s = std::size_t{}; s < numSegments; s++) {
+            auto const &seg = segments[s];
+            if (seg.guard == nullptr or seg.guard()) {
+                run_range(first, seg.last);
+            }
+            first = seg.last;
         }
 
-        for (auto const func : functionPtrs) {
-            func();
+        detail::trace_flow<trace::event::FLOW_END, Name>();
+    }
+
+    /**
+     * Run the flow from where the cursor points, one step at a time, for as
+     * long as within_budget allows.
+     *
+     * @param within_budget
+     *      Called with the number of steps run so far before each step, and
+     *      before each guard is checked. Returns whether to go on.
+     *
+     * @return
+     *      status::DONE once the last step has run, at which point the cursor
+     *      is reset so that the next slice starts the flow again.
+     */
+    template <typename Budget>
+    auto resume(cursor &c, Budget within_budget) const -> status {
+        if (not c.started) {
+            c.started = true;
+            start();
         }
 
-        if constexpr (loggingEnabled) {
-            CIB_TRACE("flow.end({})", Name{});
+        auto steps_run = std::size_t{};
+        while (c.segment < numSegments) {
+            if (not within_budget(steps_run)) {
+                return status::NOT_DONE;
+            }
+
+            auto const &seg = segments[c.segment];
+            auto const first =
+                c.segment == 0 ? std::size_t{} : segments[c.segment - 1].last;
+            if (c.step == first and seg.guard != nullptr and not seg.guard()) {
+                c.step = seg.last;
+            } else {
+                run_range(c.step, c.step + 1);
+                ++c.step;
+                ++steps_run;
+            }
+
+            if (c.step == seg.last) {
+                ++c.segment;
+            }
         }
+
+        detail::trace_flow<trace::event::FLOW_END, Name>();
+        c = cursor{};
+        return status::DONE;
+    }
+
+    /**
+     * Run at most max_steps steps of the flow, starting where the cursor
+     * points.
+     *
+     * @return
+     *      status::DONE if the flow finished within this slice.
+     */
+    auto run_slice(cursor &c, std::size_t max_steps) const -> status {
+        return resume(c, [=](std::size_t steps_run) {
+            return steps_run < max_steps;
+        });
+    }
+
+    /**
+     * Run steps of the flow, starting where the cursor points, until budget
+     * has elapsed on Clock. A step is never interrupted, so a slice can
+     * overrun by up to the duration of one step; at least one step is run
+     * in every slice.
+     *
+     * @tparam Clock
+     *      A std::chrono Clock used to measure the slice.
+     *
+     * @return
+     *      status::DONE if the flow finished within this slice.
+     */
+    template <typename Clock = std::chrono::steady_clock, typename Rep,
+              typename Period>
+    auto run_slice(cursor &c, std::chrono::duration<Rep, Period> budget) const
+        -> status {
+        auto const begin = Clock::now();
+        return resume(c, [&](std::size_t steps_run) {
+            return steps_run == 0 or Clock::now() - begin < budget;
+        });
     }
 
     /**
@@ -111,6 +284,8 @@ template <typename Name> class impl<Name, 0> {
   public:
     constexpr static bool active = false;
 
+    struct cursor {};
+
     constexpr impl(milestone_base *, build_status newBuildStatus)
         : buildStatus(newBuildStatus) {}
 
@@ -118,6 +293,11 @@ template <typename Name> class impl<Name, 0> {
         // pass
     }
 
+    template <typename... Budget>
+    auto run_slice(cursor &, Budget...) const -> status {
+        return status::DONE;
+    }
+
     [[nodiscard]] constexpr auto getBuildStatus() const -> build_status {
         return buildStatus;
     }
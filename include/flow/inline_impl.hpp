@@ -0,0 +1,119 @@
+#pragma once
+
+#include <flow/common.hpp>
+#include <flow/impl.hpp>
+#include <flow/milestone.hpp>
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace flow {
+/**
+ * flow::inline_impl is a constant representation of a flow that can be run
+ * as a single function making a direct call to every action.
+ *
+ * flow::impl loops over a table of function pointers, so every step costs an
+ * indirect call and no action can be inlined into the flow. When a
+ * flow::inline_impl is itself a constant with static storage duration, run()
+ * expands into one direct call per step in topological order, which lets the
+ * compiler inline small actions and fold away empty milestones.
+ *
+ * @tparam Name
+ *      Name of flow as a compile-time string.
+ *
+ * @tparam NumSteps
+ *      The number of Milestones this flow::inline_impl represents.
+ *
+ * @see flow::inline_builder
+ */
+template <typename Name, std::size_t NumSteps>
+class inline_impl : public interface {
+  private:
+    constexpr static bool tracingEnabled = detail::trace_milestones<Name>;
+    constexpr static auto capacity = tracingEnabled ? NumSteps * 2 : NumSteps;
+
+    std::array<FunctionPtr, capacity> functionPtrs{};
+    build_status buildStatus;
+
+    template <inline_impl const &Flow, std::size_t I>
+    static auto run_step() -> void {
+        constexpr auto func = Flow.functionPtrs[I];
+        func();
+    }
+
+    template <inline_impl const &Flow, std::size_t... Is>
+    static auto run_steps(std::index_sequence<Is...>) -> void {
+        (run_step<Flow, Is>(), ...);
+    }
+
+  public:
+    constexpr static bool active = capacity > 0;
+
+    /**
+     * Create a new flow::inline_impl of Milestones.
+     *
+     * Do not call this constructor directly, use flow::inline_builder
+     * instead.
+     *
+     * @param newMilestones
+     *      Array of Milestones to execute in the flow.
+     *
+     * @param buildStatus
+     *      flow::builder will report whether the flow::inline_impl can be
+     * built successfully.
+     */
+    constexpr inline_impl(milestone_base *newMilestones,
+                          build_status newBuildStatus)
+        : buildStatus(newBuildStatus) {
+        if constexpr (tracingEnabled) {
+            for (auto i = std::size_t{}; i < NumSteps; i++) {
+                functionPtrs[(i * 2)] = newMilestones[i].log_name;
+                functionPtrs[(i * 2) + 1] = newMilestones[i].run;
+            }
+        } else {
+            for (auto i = std::size_t{}; i < NumSteps; i++) {
+                functionPtrs[i] = newMilestones[i].run;
+            }
+        }
+    }
+
+    /**
+     * Execute the entire flow in order with a direct call to every step.
+     *
+     * @tparam Flow
+     *      The flow to run. It must have static storage duration so that its
+     *      function pointers are known at compile time.
+     */
+    template <inline_impl const &Flow> static auto run() -> void {
+        detail::trace_flow<trace::event::FLOW_BEGIN, Name>();
+
+        run_steps<Flow>(std::make_index_sequence<capacity>{});
+
+        detail::trace_flow<trace::event::FLOW_END, Name>();
+    }
+
+    /**
+     * Execute the entire flow in order through its table of function
+     * pointers. Used when the flow is not a compile-time constant.
+     */
+    auto operator()() const -> void final {
+        detail::trace_flow<trace::event::FLOW_BEGIN, Name>();
+
+        for (auto const func : functionPtrs) {
+            func();
+        }
+
+        detail::trace_flow<trace::event::FLOW_END, Name>();
+    }
+
+    /**
+     * @return
+     *      Error status of the flow::inline_impl building process.
+     */
+    [[nodiscard]] constexpr auto getBuildStatus() const -> build_status {
+        return buildStatus;
+    }
+};
+} // namespace flow
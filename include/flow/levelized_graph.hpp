@@ -0,0 +1,138 @@
+#pragma once
+
+#include <container/vector.hpp>
+#include <flow/common.hpp>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace flow {
+/**
+ * flow::levelized_graph is the constexpr result of sorting a flow graph one
+ * level at a time.
+ *
+ * The depth of a node is the number of nodes on the longest chain of
+ * dependencies that leads to it, not counting itself. Nodes that share a depth
+ * make up a level and never depend on each other. The longest chain through
+ * the whole graph is its critical path: no schedule, however parallel, can
+ * finish in fewer steps than there are nodes on it.
+ *
+ * All queries are constexpr so they can be used in static_assert as well as
+ * by runtime schedulers.
+ *
+ * @tparam Node The type of a flow node.
+ * @tparam Capacity The maximum number of nodes the graph can contain.
+ *
+ * @see flow::graph_builder::levelize
+ */
+template <typename Node, std::size_t Capacity> class levelized_graph {
+    cib::vector<Node, Capacity> nodes{};
+    cib::vector<std::size_t, Capacity> depths{};
+    cib::vector<std::size_t, Capacity> widths{};
+    cib::vector<Node, Capacity> path{};
+    build_status buildStatus{build_status::SUCCESS};
+
+    template <typename, typename, std::size_t, std::size_t, typename>
+    friend class graph_builder;
+
+  public:
+    /**
+     * @return
+     *      The number of nodes that were sorted.
+     */
+    [[nodiscard]] constexpr auto size() const -> std::size_t {
+        return nodes.size();
+    }
+
+    /**
+     * @return
+     *      The sorted nodes, in order of increasing depth.
+     */
+    [[nodiscard]] constexpr auto sorted_nodes() const
+        -> cib::vector<Node, Capacity> const & {
+        return nodes;
+    }
+
+    /**
+     * @return
+     *      The depth of each node returned by sorted_nodes(), at the same
+     *      index.
+     */
+    [[nodiscard]] constexpr auto sorted_depths() const
+        -> cib::vector<std::size_t, Capacity> const & {
+        return depths;
+    }
+
+    /**
+     * @param node
+     *      A node that was added to the graph.
+     *
+     * @return
+     *      The depth of node.
+     */
+    [[nodiscard]] constexpr auto depth_of(Node node) const -> std::size_t {
+        auto const i = std::find(nodes.begin(), nodes.end(), node);
+        CIB_ASSERT(i != nodes.end());
+        return depths[static_cast<std::size_t>(i - nodes.begin())];
+    }
+
+    /**
+     * @return
+     *      The number of levels in the graph.
+     */
+    [[nodiscard]] constexpr auto num_levels() const -> std::size_t {
+        return widths.size();
+    }
+
+    /**
+     * @param level
+     *      A level less than num_levels().
+     *
+     * @return
+     *      The number of nodes in the level.
+     */
+    [[nodiscard]] constexpr auto width_of(std::size_t level) const
+        -> std::size_t {
+        return widths[level];
+    }
+
+    /**
+     * @return
+     *      The number of nodes in the widest level: the most nodes that can
+     *      ever be ready to run at the same time.
+     */
+    [[nodiscard]] constexpr auto max_width() const -> std::size_t {
+        return widths.empty() ? 0 : *std::max_element(widths.begin(),
+                                                      widths.end());
+    }
+
+    /**
+     * @return
+     *      The nodes on a longest chain of dependencies, in the order they
+     *      must run.
+     */
+    [[nodiscard]] constexpr auto critical_path() const
+        -> cib::vector<Node, Capacity> const & {
+        return path;
+    }
+
+    /**
+     * @return
+     *      The number of nodes on the critical path. This is equal to the
+     *      number of levels.
+     */
+    [[nodiscard]] constexpr auto critical_path_length() const -> std::size_t {
+        return path.size();
+    }
+
+    /**
+     * @return
+     *      Whether every node could be sorted. If not, the graph contains a
+     *      circular dependency and the other results only describe the part
+     *      of the graph that precedes it.
+     */
+    [[nodiscard]] constexpr auto getBuildStatus() const -> build_status {
+        return buildStatus;
+    }
+};
+} // namespace flow
@@ -3,25 +3,97 @@
 #include <flow/common.hpp>
 #include <flow/detail/dependency.hpp>
 #include <flow/detail/parallel.hpp>
+#include <flow/profiling.hpp>
+
+#include <string_view>
+#include <type_traits>
 
 namespace flow {
+namespace detail {
+/**
+ * The action of every milestone. Steps that run it do no work, so they can be
+ * left out of a built flow.
+ */
+constexpr auto no_op() -> void {}
+} // namespace detail
+
 class milestone_base {
   private:
-    FunctionPtr run{};
-    FunctionPtr log_name{};
+    FunctionPtr run{detail::no_op};
+    FunctionPtr log_name{detail::no_op};
+    std::string_view name{};
+    PredicatePtr guard{};
+    FunctionPtr body{detail::no_op};
+    PollPtr poll{};
+    profiling::log_step_ptr log_profile{};
 
     template <typename Name, std::size_t NumSteps> friend class impl;
+    template <typename Name, std::size_t NumSteps> friend class inline_impl;
+    template <typename Name, std::size_t NumSteps> friend class async_impl;
+    template <typename Name, std::size_t NumSteps, executor Executor>
+    friend class parallel_impl;
+
+    template <typename Name> static auto trace_step() -> void {
+        CIB_TRACE("flow.milestone({})", Name{});
+        trace::point<trace::event::STEP, Name>();
+    }
 
   public:
     template <typename Name>
-    constexpr milestone_base([[maybe_unused]] Name name, FunctionPtr run_ptr)
+    constexpr milestone_base([[maybe_unused]] Name n, FunctionPtr run_ptr)
         : run{run_ptr},
-          log_name{[]() { CIB_TRACE("flow.milestone({})", Name{}); }} {}
+          log_name{trace_step<Name>},
+          name{Name::value}, body{run_ptr},
+          log_profile{profiling::detail::log_step<Name>} {}
+
+    template <typename Name, typename Pred, typename F>
+        requires std::is_empty_v<Pred> and std::is_empty_v<F>
+    constexpr milestone_base([[maybe_unused]] Name n, Pred pred, F f)
+        : run{[]() {
+              if (Pred{}()) {
+                  F{}();
+              }
+          }},
+          log_name{trace_step<Name>},
+          name{Name::value}, guard{pred}, body{f},
+          log_profile{profiling::detail::log_step<Name>} {}
+
+    template <typename Name, typename F>
+        requires std::is_empty_v<F> and std::is_invocable_r_v<status, F>
+    constexpr milestone_base([[maybe_unused]] Name n, F f)
+        : run{[]() { static_cast<void>(F{}()); }},
+          log_name{trace_step<Name>},
+          name{Name::value}, body{run}, poll{f},
+          log_profile{profiling::detail::log_step<Name>} {}
 
     constexpr milestone_base() = default;
 
     constexpr void operator()() const { run(); }
 
+    /**
+     * @return
+     *      Whether this is a milestone, i.e. it has no action of its own.
+     */
+    [[nodiscard]] constexpr auto is_milestone() const -> bool {
+        return run == detail::no_op;
+    }
+
+    /**
+     * @return
+     *      The name given to this action or milestone.
+     */
+    [[nodiscard]] constexpr auto get_name() const -> std::string_view {
+        return name;
+    }
+
+    /**
+     * @return
+     *      The predicate guarding this action, or nullptr if it always runs.
+     */
+    [[nodiscard]] constexpr auto predicate() const -> PredicatePtr {
+        return guard;
+    }
+
   private:
     [[nodiscard]] friend constexpr auto operator==(milestone_base const &lhs,
                                                    milestone_base const &rhs)
@@ -50,12 +122,47 @@ template <typename NameType>
     return milestone_base{name, f};
 }
 
+/**
+ * @param pred
+ *      A captureless lambda returning bool, checked each time the flow runs.
+ *
+ * @param f
+ *      A captureless lambda to execute when pred returns true.
+ *
+ * @return
+ *      New action that executes f only when pred holds. flow::builder groups
+ *      actions that share a predicate, so flow::impl checks it once for each
+ *      contiguous run of such actions rather than once per action.
+ */
+template <typename NameType, typename Pred, typename F>
+[[nodiscard]] constexpr auto action_if(NameType name, Pred pred, F f) {
+    return milestone_base{name, pred, f};
+}
+
+/**
+ * @param f
+ *      A captureless lambda returning flow::status. It is called repeatedly
+ *      until it returns status::DONE.
+ *
+ * @return
+ *      New action that may take several calls to complete. A
+ *      flow::async_service polls it alongside the other pending actions of the
+ *      flow and holds back the steps that depend on it until it is done. Any
+ *      other flow polls it once each time the flow runs and does not wait
+ *      for it, so put actions that others depend on in an async flow.
+ */
+template <typename NameType, typename F>
+    requires std::is_empty_v<F> and std::is_invocable_r_v<status, F>
+[[nodiscard]] constexpr auto async_action(NameType name, F f) {
+    return milestone_base{name, f};
+}
+
 /**
  * @return
  *      New milestone_base with no associated action.
  */
 template <typename NameType>
 [[nodiscard]] constexpr auto milestone(NameType name) {
-    return milestone_base{name, []() {}};
+    return milestone_base{name, detail::no_op};
 }
 } // namespace flow
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <flow/common.hpp>
+#include <flow/impl.hpp>
+#include <flow/milestone.hpp>
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace flow {
+/**
+ * flow::serial_executor runs every action of a batch on the calling thread,
+ * one after another.
+ */
+struct serial_executor {
+    auto run(FunctionPtr const *first, FunctionPtr const *last) const -> void {
+        for (; first != last; ++first) {
+            (*first)();
+        }
+    }
+};
+
+/**
+ * flow::parallel_impl is a constant representation of a flow whose steps are
+ * grouped into levels.
+ *
+ * Every step in a level depends only on steps from earlier levels, so the
+ * steps of one level may run concurrently. Each level is handed to an
+ * executor as a single batch, and the next level is not started until the
+ * executor has finished the previous one. Every ordering constraint given to
+ * the flow::builder is therefore respected no matter how the executor
+ * schedules a batch.
+ *
+ * @tparam Name
+ *      Name of flow as a compile-time string.
+ *
+ * @tparam NumSteps
+ *      The number of Milestones this flow::parallel_impl represents.
+ *
+ * @tparam Executor
+ *      The executor used when the flow is run without one being given.
+ *
+ * @see flow::parallel_builder
+ */
+template <typename Name, std::size_t NumSteps,
+          executor Executor = serial_executor>
+class parallel_impl : public interface {
+  private:
+    constexpr static bool tracingEnabled = detail::trace_milestones<Name>;
+
+    std::array<FunctionPtr, NumSteps> functionPtrs{};
+    std::array<FunctionPtr, tracingEnabled ? NumSteps : 0> logPtrs{};
+    std::array<std::size_t, NumSteps + 1> levelOffsets{};
+    std::size_t numLevels{};
+    build_status buildStatus;
+
+  public:
+    constexpr static bool active = NumSteps > 0;
+
+    /**
+     * Create a new flow::parallel_impl of Milestones.
+     *
+     * Do not call this constructor directly, use flow::parallel_builder
+     * instead.
+     *
+     * @param newMilestones
+     *      Array of Milestones to execute in the flow, ordered by level.
+     *
+     * @param levels
+     *      The level of each Milestone in newMilestones.
+     *
+     * @param buildStatus
+     *      flow::builder will report whether the flow::parallel_impl can be
+     * built successfully.
+     */
+    constexpr parallel_impl(milestone_base *newMilestones,
+                            std::size_t const *levels,
+                            build_status newBuildStatus)
+        : buildStatus(newBuildStatus) {
+        for (auto i = std::size_t{}; i < NumSteps; i++) {
+            functionPtrs[i] = newMilestones[i].run;
+            if constexpr (tracingEnabled) {
+                logPtrs[i] = newMilestones[i].log_name;
+            }
+
+            if (i == 0 or levels[i] != levels[i - 1]) {
+                levelOffsets[numLevels++] = i;
+            }
+        }
+        levelOffsets[numLevels] = NumSteps;
+    }
+
+    /**
+     * Execute the entire flow, one level at a time, using the given executor.
+     */
+    template <executor E> auto operator()(E &&exec) const -> void {
+        detail::trace_flow<trace::event::FLOW_BEGIN, Name>();
+
+        for (auto level = std::size_t{}; level < numLevels; level++) {
+            auto const first = levelOffsets[level];
+            auto const last = levelOffsets[level + 1];
+
+            if constexpr (tracingEnabled) {
+                for (auto i = first; i < last; i++) {
+                    logPtrs[i]();
+                }
+            }
+
+            exec.run(functionPtrs.data() + first, functionPtrs.data() + last);
+        }
+
+        detail::trace_flow<trace::event::FLOW_END, Name>();
+    }
+
+    /**
+     * Execute the entire flow using a default-constructed Executor.
+     */
+    auto operator()() const -> void final { (*this)(Executor{}); }
+
+    /**
+     * @return
+     *      The number of levels in the flow.
+     */
+    [[nodiscard]] constexpr auto getNumLevels() const -> std::size_t {
+        return numLevels;
+    }
+
+    /**
+     * @return
+     *      Error status of the flow::parallel_impl building process.
+     */
+    [[nodiscard]] constexpr auto getBuildStatus() const -> build_status {
+        return buildStatus;
+    }
+};
+} // namespace flow
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <log/log.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace flow::profiling {
+/**
+ * The default profiling configuration: flows are not instrumented at all.
+ */
+struct disabled {};
+
+/**
+ * Profile every named flow, timing each step with Clock.
+ *
+ * @tparam Clock
+ *      A type meeting the std::chrono Clock requirements, e.g.
+ *      std::chrono::steady_clock or a wrapper around a cycle counter.
+ */
+template <typename Clock> struct enabled {
+    using clock = Clock;
+};
+
+/**
+ * Programs select profiling by specializing this variable template, in the
+ * same way as logging::config:
+ *
+ * <pre>
+ *   template <>
+ *   inline auto flow::profiling::config<> =
+ *       flow::profiling::enabled<std::chrono::steady_clock>{};
+ * </pre>
+ *
+ * Left unspecialized, flows are not instrumented.
+ */
+template <typename...> inline auto config = disabled{};
+
+namespace detail {
+template <typename Name, typename... Ts> struct traits {
+    using config_t = std::remove_cvref_t<decltype(config<Ts...>)>;
+    constexpr static bool enabled =
+        not std::is_void_v<Name> and not std::is_same_v<config_t, disabled>;
+};
+} // namespace detail
+
+/**
+ * Whether the flow named Name is profiled. Only named flows are profiled,
+ * since the results are looked up by name.
+ */
+template <typename Name, typename... Ts>
+constexpr static bool is_enabled = detail::traits<Name, Ts...>::enabled;
+
+template <typename Name, typename... Ts>
+using clock_type = typename detail::traits<Name, Ts...>::config_t::clock;
+
+template <typename Name, typename... Ts>
+using duration_type = typename clock_type<Name, Ts...>::duration;
+
+/**
+ * Timing statistics for one step of a flow.
+ */
+template <typename Duration> struct step_stats {
+    Duration last{};
+    Duration min{Duration::max()};
+    Duration max{Duration::zero()};
+    Duration total{Duration::zero()};
+    std::size_t count{};
+
+    constexpr auto add(Duration d) -> void {
+        last = d;
+        min = d < min ? d : min;
+        max = d > max ? d : max;
+        total += d;
+        ++count;
+    }
+
+    [[nodiscard]] constexpr auto average() const -> Duration {
+        return count == 0
+                   ? Duration::zero()
+                   : total / static_cast<typename Duration::rep>(count);
+    }
+};
+
+/**
+ * Logs the statistics of one step under its name. Log messages only take
+ * names as compile-time strings, so each step brings its own function.
+ */
+using log_step_ptr = auto (*)(std::size_t index, std::size_t runs,
+                              std::int64_t last, std::int64_t min,
+                              std::int64_t max, std::int64_t avg) -> void;
+
+namespace detail {
+template <typename StepName>
+auto log_step(std::size_t index, std::size_t runs, std::int64_t last,
+              std::int64_t min, std::int64_t max, std::int64_t avg) -> void {
+    CIB_INFO("flow.profile step {} ({}): runs={} last={} min={} max={} "
+             "avg={}",
+             index, StepName{}, runs, last, min, max, avg);
+}
+} // namespace detail
+
+/**
+ * A view of the statistics gathered for every step of one flow.
+ */
+template <typename Duration> class results_view {
+    step_stats<Duration> const *steps{};
+    std::string_view const *step_names{};
+    log_step_ptr const *step_logs{};
+    std::size_t num_steps{};
+
+  public:
+    constexpr results_view() = default;
+
+    constexpr results_view(step_stats<Duration> const *s,
+                           std::string_view const *n,
+                           log_step_ptr const *l, std::size_t size)
+        : steps{s}, step_names{n}, step_logs{l}, num_steps{size} {}
+
+    /**
+     * @return
+     *      The number of steps, or zero if the flow has not run yet.
+     */
+    [[nodiscard]] constexpr auto size() const -> std::size_t {
+        return num_steps;
+    }
+
+    [[nodiscard]] constexpr auto operator[](std::size_t i) const
+        -> step_stats<Duration> const & {
+        return steps[i];
+    }
+
+    [[nodiscard]] constexpr auto name(std::size_t i) const
+        -> std::string_view {
+        return step_names[i];
+    }
+
+    /**
+     * Log the statistics of step i at INFO level, under its name.
+     */
+    auto log(std::size_t i) const -> void {
+        if (step_logs[i] != nullptr) {
+            auto const &s = steps[i];
+            step_logs[i](i, s.count, static_cast<std::int64_t>(s.last.count()),
+                         static_cast<std::int64_t>(s.min.count()),
+                         static_cast<std::int64_t>(s.max.count()),
+                         static_cast<std::int64_t>(s.average().count()));
+        }
+    }
+};
+
+/**
+ * The statistics for every step of each flow::impl, in the order the steps
+ * are run.
+ */
+template <typename Name, std::size_t NumSteps, typename... Ts>
+inline std::array<step_stats<duration_type<Name, Ts...>>, NumSteps> storage{};
+
+/**
+ * The profiling results of the flow named Name. Results become available
+ * once the flow has run for the first time.
+ */
+template <typename Name, typename... Ts>
+inline results_view<duration_type<Name, Ts...>> results{};
+
+/**
+ * Log the profiling results of the flow named Name at INFO level: a line
+ * naming the flow, then a line for each step giving its index into the
+ * results and its name. Durations are given in ticks of the configured
+ * clock.
+ */
+template <typename Name, typename... Ts> auto log_results() -> void {
+    auto const &r = results<Name, Ts...>;
+    CIB_INFO("flow.profile({}): {} steps", Name{}, r.size());
+    for (auto i = std::size_t{}; i < r.size(); ++i) {
+        r.log(i);
+    }
+}
+} // namespace flow::profiling
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <flow/detail/bitset.hpp>
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace flow {
+/**
+ * flow::reachability records, for every pair of nodes of a sorted flow,
+ * whether one depends on the other directly or through other nodes.
+ *
+ * Nodes are identified by their positions in the sorted output, so a node
+ * only ever depends on nodes before it. Each node keeps the nodes that
+ * depend on it as a row of bits.
+ *
+ * @tparam Capacity The maximum number of nodes.
+ *
+ * @see flow::graph_builder::topo_sort
+ */
+template <std::size_t Capacity> class reachability {
+    std::array<detail::bitset<Capacity>, Capacity> reaches{};
+
+  public:
+    /**
+     * Record that the node at position later depends on the node at position
+     * earlier.
+     */
+    constexpr auto add(std::size_t earlier, std::size_t later) -> void {
+        reaches[earlier].insert(later);
+    }
+
+    /**
+     * Record that the node at position later depends on the node at position
+     * earlier, and so does every node already recorded as depending on later.
+     */
+    constexpr auto add_through(std::size_t earlier, std::size_t later)
+        -> void {
+        add(earlier, later);
+        reaches[earlier] |= reaches[later];
+    }
+
+    /**
+     * @return
+     *      Whether the node at position later depends, directly or through
+     *      other nodes, on the node at position earlier.
+     */
+    [[nodiscard]] constexpr auto depends_on(std::size_t later,
+                                            std::size_t earlier) const
+        -> bool {
+        return reaches[earlier].contains(later);
+    }
+
+    /**
+     * @return
+     *      The positions of every node that depends on the node at position
+     *      earlier.
+     */
+    [[nodiscard]] constexpr auto dependents_of(std::size_t earlier) const
+        -> detail::bitset<Capacity> const & {
+        return reaches[earlier];
+    }
+
+    /**
+     * Call f with the position of every node that depends on the node at
+     * position earlier, in increasing order.
+     */
+    template <typename F>
+    constexpr auto for_each_dependent(std::size_t earlier, F &&f) const
+        -> void {
+        reaches[earlier].for_each(std::forward<F>(f));
+    }
+};
+} // namespace flow
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <container/vector.hpp>
+
+#include <cstddef>
+
+namespace flow {
+/**
+ * flow::residual_graph is the constexpr part of a flow graph that cannot be
+ * sorted.
+ *
+ * Starting from the whole graph, nodes with no remaining dependencies are
+ * removed, and so are nodes that nothing remaining depends on. What is left
+ * are the nodes on circular dependencies and on the paths between them,
+ * together with the edges among those nodes. A graph that can be sorted
+ * leaves an empty residual graph.
+ *
+ * @tparam Node The type of a flow node.
+ * @tparam NodeCapacity The maximum number of nodes the graph can contain.
+ * @tparam EdgeCapacity The average number of edges out of each node.
+ *
+ * @see flow::graph_builder::residual
+ */
+template <typename Node, std::size_t NodeCapacity, std::size_t EdgeCapacity>
+class residual_graph {
+  public:
+    /**
+     * A dependency between two nodes, given by their indices in
+     * remaining_nodes().
+     */
+    struct edge {
+        std::size_t from{};
+        std::size_t to{};
+    };
+
+  private:
+    cib::vector<Node, NodeCapacity> nodes{};
+    cib::vector<edge, NodeCapacity * EdgeCapacity> edges{};
+    cib::vector<Node, NodeCapacity> loop{};
+
+    template <typename, typename, std::size_t, std::size_t, typename>
+    friend class graph_builder;
+
+  public:
+    /**
+     * @return
+     *      Whether the graph could be sorted completely.
+     */
+    [[nodiscard]] constexpr auto empty() const -> bool {
+        return nodes.empty();
+    }
+
+    /**
+     * @return
+     *      The nodes that could not be sorted, in the order they were added to
+     *      the builder.
+     */
+    [[nodiscard]] constexpr auto remaining_nodes() const
+        -> cib::vector<Node, NodeCapacity> const & {
+        return nodes;
+    }
+
+    /**
+     * @return
+     *      The dependencies between the nodes that could not be sorted.
+     */
+    [[nodiscard]] constexpr auto remaining_edges() const
+        -> cib::vector<edge, NodeCapacity * EdgeCapacity> const & {
+        return edges;
+    }
+
+    /**
+     * @return
+     *      One circular dependency, in the order its nodes depend on each
+     *      other. Each node depends on the one before it and the first node
+     *      depends on the last. Empty if the graph could be sorted.
+     */
+    [[nodiscard]] constexpr auto cycle() const
+        -> cib::vector<Node, NodeCapacity> const & {
+        return loop;
+    }
+};
+
+namespace detail {
+/**
+ * A string usable as a template argument, so that it is printed in compiler
+ * diagnostics.
+ */
+template <std::size_t N> struct fixed_text {
+    char value[N];
+};
+} // namespace detail
+
+/**
+ * Instantiated by the flow builders when a flow has a circular dependency.
+ * The compiler prints the template argument, which spells out the cycle with
+ * the names of its actions and milestones, e.g.
+ *
+ * <pre>
+ *   In instantiation of 'struct flow::circular_dependency<
+ *       flow::detail::fixed_text<12>{"a >> b >> a"}>'
+ * </pre>
+ */
+template <detail::fixed_text Cycle> struct circular_dependency {
+    static_assert(Cycle.value[0] == '\0',
+                  "flow has a circular dependency: the cycle is the template "
+                  "argument of flow::circular_dependency above");
+};
+} // namespace flow
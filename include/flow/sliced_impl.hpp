@@ -0,0 +1,49 @@
+#pragma once
+
+#include <flow/common.hpp>
+#include <flow/impl.hpp>
+
+#include <cstddef>
+
+namespace flow {
+/**
+ * flow::sliced_impl is a flow::impl that runs a bounded slice of its steps
+ * each time it is called, resuming where it stopped on the next call.
+ *
+ * Calling a sliced flow from a cooperative main loop bounds the time each
+ * iteration of the loop spends in the flow, at the cost of spreading one
+ * run of the flow over several iterations.
+ *
+ * @tparam Name
+ *      Name of flow as a compile-time string.
+ *
+ * @tparam NumSteps
+ *      The number of Milestones this flow::sliced_impl represents.
+ *
+ * @tparam StepsPerCall
+ *      The maximum number of steps run by each call.
+ *
+ * @see flow::sliced_builder
+ * @see flow::impl::run_slice
+ */
+template <typename Name, std::size_t NumSteps, std::size_t StepsPerCall>
+class sliced_impl : public impl<Name, NumSteps> {
+    static_assert(StepsPerCall > 0, "a sliced flow must run at least one step "
+                                    "per call");
+
+  public:
+    using impl<Name, NumSteps>::impl;
+
+    /**
+     * Run the next slice of the flow. Its cursor is kept with the flow, so
+     * each sliced flow has exactly one run in progress at a time.
+     *
+     * @tparam Flow
+     *      The flow to run. It must have static storage duration.
+     */
+    template <sliced_impl const &Flow> static auto run() -> void {
+        static typename impl<Name, NumSteps>::cursor progress{};
+        static_cast<void>(Flow.run_slice(progress, StepsPerCall));
+    }
+};
+} // namespace flow
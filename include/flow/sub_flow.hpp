@@ -0,0 +1,70 @@
+#pragma once
+
+#include <flow/builder.hpp>
+#include <flow/common.hpp>
+#include <flow/inline_impl.hpp>
+#include <flow/milestone.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+namespace flow {
+namespace detail {
+template <typename Name, std::size_t NodeCapacity, std::size_t EdgeCapacity,
+          typename Description>
+struct sorted_sub_flow {
+    constexpr static auto value = [] {
+        inline_builder<Name, NodeCapacity, EdgeCapacity> builder;
+        builder.add(Description{}());
+        return builder;
+    }();
+
+    constexpr static auto steps =
+        value.template topo_sort<inline_impl, value.num_steps()>();
+
+    static auto run() -> void {
+        if constexpr (steps.getBuildStatus() != build_status::SUCCESS) {
+            std::remove_cvref_t<decltype(value)>::template report_cycle<
+                sorted_sub_flow>();
+        }
+        std::remove_cvref_t<decltype(steps)>::template run<steps>();
+    }
+};
+} // namespace detail
+
+/**
+ * Sort part of a flow on its own and wrap it up as a single action.
+ *
+ * The description is sorted once, when the sub-flow is defined, into a flow
+ * that runs with a direct call to each of its steps. A flow that the sub-flow
+ * is added to sees only one node, so adding a large component to a flow
+ * costs one node and its cross-edges when the whole flow is sorted, rather
+ * than every node and edge of the component.
+ *
+ * Dependencies can only be expressed on the sub-flow as a whole, not on the
+ * steps inside it.
+ *
+ * @tparam NodeCapacity
+ *      The maximum number of actions and milestones in the sub-flow.
+ *
+ * @tparam EdgeCapacity
+ *      The average number of dependencies from each action or milestone of the
+ *      sub-flow to another.
+ *
+ * @param description
+ *      A captureless lambda returning the sub-flow's description, e.g.
+ *      [] { return a >> b >> c; }
+ *
+ * @return
+ *      New action that runs every step of the sub-flow in order.
+ */
+template <std::size_t NodeCapacity = 64, std::size_t EdgeCapacity = 16,
+          typename NameType, typename Description>
+    requires std::is_empty_v<Description>
+[[nodiscard]] constexpr auto sub_flow(NameType name, Description) {
+    using sorted =
+        detail::sorted_sub_flow<NameType, NodeCapacity, EdgeCapacity,
+                                Description>;
+    return milestone_base{name, sorted::run};
+}
+} // namespace flow
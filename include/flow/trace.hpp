@@ -0,0 +1,270 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+namespace flow::trace {
+/**
+ * The kind of a trace record. A step lasts until the next record written
+ * by the same thread.
+ */
+enum class event : std::uint8_t { FLOW_BEGIN = 0, FLOW_END = 1, STEP = 2 };
+
+/**
+ * One entry of the trace buffer: 16 bytes, with no formatting done on the
+ * target.
+ */
+struct record {
+    std::uint64_t timestamp{};
+    std::uint32_t id{};
+    std::uint16_t thread{};
+    event kind{};
+};
+
+/**
+ * @return
+ *      The 32-bit FNV-1a hash of a name, used as its id in trace records.
+ */
+[[nodiscard]] constexpr auto hash(std::string_view name) -> std::uint32_t {
+    auto h = std::uint32_t{2166136261u};
+    for (auto const c : name) {
+        h ^= static_cast<std::uint8_t>(c);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+template <typename Name>
+constexpr static std::uint32_t id_of = hash(Name::value);
+
+/**
+ * The default thread id policy: every record is attributed to thread 0.
+ */
+struct single_thread {
+    constexpr static auto current() -> std::uint16_t { return 0; }
+};
+
+/**
+ * A fixed-size, lock-free ring buffer of trace records. Writers claim a slot
+ * with a single atomic increment; once the buffer is full the oldest records
+ * are overwritten. Dump the buffer while no thread is writing to it.
+ *
+ * The write count is kept as two 32-bit atomics, so the buffer stays
+ * lock-free on targets without 64-bit atomics and keeps counting past 2^32
+ * records.
+ *
+ * @tparam Capacity
+ *      The number of records kept. Must be a power of two.
+ */
+template <std::size_t Capacity> class ring_buffer {
+    static_assert(Capacity > 0 and (Capacity & (Capacity - 1)) == 0,
+                  "ring_buffer capacity must be a power of two");
+
+    std::array<record, Capacity> records{};
+    std::atomic<std::uint32_t> head{};
+    std::atomic<std::uint32_t> wraps{};
+
+    [[nodiscard]] auto written() const -> std::uint64_t {
+        return (std::uint64_t{wraps.load(std::memory_order_relaxed)} << 32u) |
+               head.load(std::memory_order_relaxed);
+    }
+
+  public:
+    constexpr ring_buffer() = default;
+
+    /**
+     * Create a buffer whose write count starts at written, as though that
+     * many records had already been written.
+     */
+    constexpr explicit ring_buffer(std::uint64_t written)
+        : head{static_cast<std::uint32_t>(written)},
+          wraps{static_cast<std::uint32_t>(written >> 32u)} {}
+
+    auto write(record const &r) -> void {
+        auto const i = head.fetch_add(1, std::memory_order_relaxed);
+        if (i == std::numeric_limits<std::uint32_t>::max()) {
+            wraps.fetch_add(1, std::memory_order_relaxed);
+        }
+        records[i & (Capacity - 1)] = r;
+    }
+
+    /**
+     * @return
+     *      The number of records held, at most Capacity.
+     */
+    [[nodiscard]] auto size() const -> std::size_t {
+        return static_cast<std::size_t>(
+            std::min<std::uint64_t>(written(), Capacity));
+    }
+
+    /**
+     * @return
+     *      The number of records overwritten because the buffer was full.
+     */
+    [[nodiscard]] auto dropped() const -> std::uint64_t {
+        return written() - size();
+    }
+
+    /**
+     * @return
+     *      The i-th oldest record held.
+     */
+    [[nodiscard]] auto operator[](std::size_t i) const -> record const & {
+        auto const first = written() - size();
+        return records[static_cast<std::size_t>(first + i) & (Capacity - 1)];
+    }
+};
+
+/**
+ * The default trace configuration: nothing is recorded.
+ */
+struct disabled {};
+
+/**
+ * A trace sink recording flow events into a ring buffer.
+ *
+ * @tparam Clock
+ *      A std::chrono Clock used to timestamp records.
+ *
+ * @tparam Capacity
+ *      The number of records kept. Must be a power of two.
+ *
+ * @tparam NameCapacity
+ *      The maximum number of distinct flow and step names.
+ *
+ * @tparam ThreadId
+ *      A type whose static current() returns an id for the calling thread.
+ */
+template <typename Clock, std::size_t Capacity = 1024,
+          std::size_t NameCapacity = 64, typename ThreadId = single_thread>
+class sink {
+    struct name_entry {
+        std::uint32_t id{};
+        std::string_view name{};
+    };
+
+    ring_buffer<Capacity> buffer{};
+    std::array<name_entry, NameCapacity> names{};
+    std::atomic<std::uint32_t> num_names{};
+
+    template <typename OutputIt, typename T>
+    static auto put(OutputIt out, T value) -> OutputIt {
+        for (auto i = std::size_t{}; i < sizeof(T); ++i) {
+            *out++ = static_cast<std::uint8_t>(
+                static_cast<std::uint64_t>(value) >> (8u * i));
+        }
+        return out;
+    }
+
+  public:
+    constexpr sink() = default;
+
+    auto write(event kind, std::uint32_t id) -> void {
+        auto const now = Clock::now().time_since_epoch().count();
+        buffer.write({static_cast<std::uint64_t>(now), id,
+                      ThreadId::current(), kind});
+    }
+
+    /**
+     * Record the name behind an id so that dumps can be symbolized. Names
+     * beyond NameCapacity are ignored.
+     */
+    auto add_name(std::uint32_t id, std::string_view name) -> void {
+        auto const i = num_names.fetch_add(1, std::memory_order_relaxed);
+        if (i < NameCapacity) {
+            names[i] = {id, name};
+        }
+    }
+
+    [[nodiscard]] auto records() const -> ring_buffer<Capacity> const & {
+        return buffer;
+    }
+
+    /**
+     * Write the names and records out as bytes, for conversion on the host
+     * with tools/flow_trace_to_chrome.py. All fields are little-endian:
+     *
+     * <pre>
+     *   "CIBT" u32:version u64:period_num u64:period_den
+     *   u32:num_names  { u32:id u32:length char[length] }...
+     *   u32:num_records { u64:timestamp u32:id u16:thread u8:kind u8:0 }...
+     * </pre>
+     *
+     * @param out
+     *      An output iterator accepting std::uint8_t.
+     */
+    template <typename OutputIt> auto dump(OutputIt out) const -> OutputIt {
+        using period = typename Clock::period;
+        for (auto const c : std::string_view{"CIBT"}) {
+            *out++ = static_cast<std::uint8_t>(c);
+        }
+        out = put(out, std::uint32_t{1});
+        out = put(out, static_cast<std::uint64_t>(period::num));
+        out = put(out, static_cast<std::uint64_t>(period::den));
+
+        auto const n = std::min<std::size_t>(
+            num_names.load(std::memory_order_relaxed), NameCapacity);
+        out = put(out, static_cast<std::uint32_t>(n));
+        for (auto i = std::size_t{}; i < n; ++i) {
+            out = put(out, names[i].id);
+            out = put(out, static_cast<std::uint32_t>(names[i].name.size()));
+            for (auto const c : names[i].name) {
+                *out++ = static_cast<std::uint8_t>(c);
+            }
+        }
+
+        out = put(out, static_cast<std::uint32_t>(buffer.size()));
+        for (auto i = std::size_t{}; i < buffer.size(); ++i) {
+            auto const &r = buffer[i];
+            out = put(out, r.timestamp);
+            out = put(out, r.id);
+            out = put(out, r.thread);
+            out = put(out, static_cast<std::uint8_t>(r.kind));
+            out = put(out, std::uint8_t{});
+        }
+        return out;
+    }
+};
+
+/**
+ * Programs select a trace sink by specializing this variable template, in
+ * the same way as logging::config:
+ *
+ * <pre>
+ *   template <>
+ *   inline auto flow::trace::config<> =
+ *       flow::trace::sink<std::chrono::steady_clock, 4096>{};
+ * </pre>
+ *
+ * Left unspecialized, nothing is recorded.
+ */
+template <typename...> inline auto config = disabled{};
+
+template <typename... Ts>
+constexpr static bool is_enabled =
+    not std::is_same_v<std::remove_cvref_t<decltype(config<Ts...>)>,
+                       disabled>;
+
+namespace detail {
+template <typename Name, typename... Ts>
+inline bool const registered =
+    (config<Ts...>.add_name(id_of<Name>, Name::value), true);
+} // namespace detail
+
+/**
+ * Write a record for Name to the configured sink, if there is one. Each
+ * name is registered with the sink once, during static initialization.
+ */
+template <event E, typename Name, typename... Ts> auto point() -> void {
+    if constexpr (is_enabled<Ts...>) {
+        static_cast<void>(detail::registered<Name, Ts...>);
+        config<Ts...>.write(E, id_of<Name>);
+    }
+}
+} // namespace flow::trace
@@ -44,7 +44,7 @@ template <typename ConfigT> struct sub_irq_builder {
         constexpr auto run_flow = [] {
             auto constexpr flow_builder =
                 BuilderValue::value.interrupt_service_routine;
-            auto constexpr flow_size = flow_builder.size();
+            auto constexpr flow_size = flow_builder.num_steps();
             auto constexpr flow =
                 flow_builder.template topo_sort<flow::impl, flow_size>();
             flow();
@@ -52,7 +52,7 @@ template <typename ConfigT> struct sub_irq_builder {
 
         constexpr auto flow_builder =
             BuilderValue::value.interrupt_service_routine;
-        constexpr auto flow_size = flow_builder.size();
+        constexpr auto flow_size = flow_builder.num_steps();
         auto const optimized_irq_impl =
             sub_irq_impl<ConfigT,
                          flow::impl<typename IrqCallbackType::Name, flow_size>>(
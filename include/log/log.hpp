@@ -4,15 +4,18 @@
 #include <sc/format.hpp>
 #include <sc/string_constant.hpp>
 
+#include <type_traits>
 #include <utility>
 
 namespace logging {
 namespace null {
+struct logger {
+    template <level L, typename... Ts>
+    constexpr auto log(Ts &&...) const noexcept -> void {}
+};
+
 struct config {
-    struct {
-        template <level L, typename... Ts>
-        constexpr auto log(Ts &&...) const noexcept -> void {}
-    } logger;
+    null::logger logger;
 
     constexpr static auto terminate() noexcept -> void {}
 };
@@ -20,10 +23,31 @@ struct config {
 
 template <typename...> inline auto config = null::config{};
 
+namespace detail {
+template <typename Config> constexpr auto max_level() -> level {
+    if constexpr (requires { Config::max_level; }) {
+        return Config::max_level;
+    } else {
+        return level::TRACE;
+    }
+}
+} // namespace detail
+
+/**
+ * Whether messages at level L reach the logger. A config may declare a
+ * constexpr static max_level; messages less severe than that are compiled
+ * out. Configs without a max_level log every level.
+ */
+template <level L, typename... Ts>
+constexpr static bool is_enabled =
+    L <= detail::max_level<std::remove_cvref_t<decltype(config<Ts...>)>>();
+
 template <level L, typename... Ts, typename... TArgs>
 static auto log(TArgs &&...args) -> void {
-    auto &cfg = config<Ts...>;
-    cfg.logger.template log<L>(std::forward<TArgs>(args)...);
+    if constexpr (is_enabled<L, Ts...>) {
+        auto &cfg = config<Ts...>;
+        cfg.logger.template log<L>(std::forward<TArgs>(args)...);
+    }
 }
 
 template <typename... Ts> static auto terminate() -> void {
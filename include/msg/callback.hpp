@@ -6,11 +6,9 @@
 
 namespace msg {
 
-template <typename CallableT, typename DataIterableT,
-          typename... ExtraCallbackArgsT>
-void dispatch_single_callable(CallableT const &callable,
-                              DataIterableT const &data,
-                              ExtraCallbackArgsT const &...args) {
+template <typename CallableT, typename MsgT, typename... ExtraCallbackArgsT>
+void invoke_callable(CallableT const &callable, MsgT const &msg,
+                     ExtraCallbackArgsT const &...args) {
     auto const provided_args_tuple = cib::make_tuple(args...);
     auto const required_args_tuple = cib::transform(
         [&](auto requiredArg) {
@@ -19,14 +17,8 @@ void dispatch_single_callable(CallableT const &callable,
         },
         detail::func_args_v<CallableT>);
 
-    required_args_tuple.apply([&](auto const &...requiredArgs) {
-        using MsgType = detail::msg_type_t<decltype(callable)>;
-        MsgType const msg{data};
-
-        if (msg.isValid()) {
-            callable(msg, requiredArgs...);
-        }
-    });
+    required_args_tuple.apply(
+        [&](auto const &...requiredArgs) { callable(msg, requiredArgs...); });
 }
 
 template <typename...> struct callback_impl;
@@ -36,6 +28,39 @@ template <typename...> struct extra_callback_args {};
 namespace detail {
 template <typename T>
 concept not_nullptr = not std::is_null_pointer_v<T>;
+
+template <typename Unique, typename... Ts> struct unique_types {
+    using type = Unique;
+};
+
+template <typename... Us, typename T, typename... Ts>
+struct unique_types<cib::tuple<Us...>, T, Ts...>
+    : unique_types<std::conditional_t<(std::is_same_v<T, Us> or ...),
+                                      cib::tuple<Us...>, cib::tuple<Us..., T>>,
+                   Ts...> {};
+
+/**
+ * A message decoded from its raw data, together with whether it is valid.
+ */
+template <typename MsgType> struct decoded_msg {
+    MsgType msg;
+    bool valid;
+
+    template <typename BaseMsgT>
+    explicit decoded_msg(BaseMsgT const &base)
+        : msg{base}, valid{msg.isValid()} {}
+};
+
+template <typename MsgTypes> struct decoder;
+
+template <typename... MsgTypes> struct decoder<cib::tuple<MsgTypes...>> {
+    using type = cib::tuple<decoded_msg<MsgTypes>...>;
+
+    template <typename BaseMsgT>
+    [[nodiscard]] static auto decode(BaseMsgT const &base) -> type {
+        return type{decoded_msg<MsgTypes>{base}...};
+    }
+};
 } // namespace detail
 
 /**
@@ -52,12 +77,30 @@ struct callback_impl<BaseMsgT, extra_callback_args<ExtraCallbackArgsT...>,
     MatchMsgTypeT match_msg;
     cib::tuple<CallableTypesT...> callbacks;
 
-    template <typename DataIterableType>
-    void dispatch(DataIterableType const &data,
+    /**
+     * The distinct message types of the callables, each decoded once.
+     */
+    using decoder_t = detail::decoder<typename detail::unique_types<
+        cib::tuple<>, detail::msg_type_t<CallableTypesT>...>::type>;
+    using decoded_msgs_t = typename decoder_t::type;
+
+    [[nodiscard]] static auto any_valid(decoded_msgs_t const &decoded)
+        -> bool {
+        return decoded.fold_left(false, [](bool state, auto const &d) {
+            return state or d.valid;
+        });
+    }
+
+    void dispatch(decoded_msgs_t const &decoded,
                   ExtraCallbackArgsT const &...args) const {
         cib::for_each(
             [&](auto const &callback) {
-                dispatch_single_callable(callback, data, args...);
+                using MsgType = detail::msg_type_t<decltype(callback)>;
+                auto const &d =
+                    cib::get<detail::decoded_msg<MsgType>>(decoded);
+                if (d.valid) {
+                    invoke_callable(callback, d.msg, args...);
+                }
             },
             callbacks);
     }
@@ -79,31 +122,48 @@ struct callback_impl<BaseMsgT, extra_callback_args<ExtraCallbackArgsT...>,
     constexpr explicit callback_impl(MatchMsgTypeT const &msg, CBs &&...cbs)
         : match_msg(msg), callbacks{std::forward<CBs>(cbs)...} {}
 
+    /**
+     * @return
+     *      The matcher a message must satisfy to be handled by this callback:
+     *      match_msg, and the requirements of at least one of the callables'
+     *      message types.
+     */
+    [[nodiscard]] constexpr auto matcher() const {
+        return match::all(match_msg, match_any_callback());
+    }
+
     [[nodiscard]] auto is_match(BaseMsgT const &msg) const -> bool {
-        return match::all(match_msg, match_any_callback())(msg);
+        return match_msg(msg) and any_valid(decoder_t::decode(msg));
     }
 
+    /**
+     * Handle msg if it matches. The message is decoded and validated once
+     * for each distinct message type of the callables, and each callable
+     * whose message type is valid is called with the decoded message.
+     *
+     * @return
+     *      Whether the message matched.
+     */
     [[nodiscard]] auto handle(BaseMsgT const &msg,
                               ExtraCallbackArgsT const &...args) const -> bool {
-        auto match_handler = match::all(match_msg, match_any_callback());
-
-        if (match_handler(msg)) {
-            CIB_INFO("Incoming message matched [{}], because [{}], executing "
-                     "callback",
-                     name, match_handler.describe());
-
-            dispatch(msg, args...);
-
-            return true;
+        if (not match_msg(msg)) {
+            return false;
+        }
+        auto const decoded = decoder_t::decode(msg);
+        if (not any_valid(decoded)) {
+            return false;
         }
 
-        return false;
+        CIB_INFO("Incoming message matched [{}], because [{}], executing "
+                 "callback",
+                 name, matcher().describe());
+
+        dispatch(decoded, args...);
+        return true;
     }
 
     auto log_mismatch(BaseMsgT const &msg) const -> void {
-        CIB_INFO(
-            "    {} - F:({})", name,
-            match::all(match_msg, match_any_callback()).describe_match(msg));
+        CIB_INFO("    {} - F:({})", name, matcher().describe_match(msg));
     }
 };
 
@@ -0,0 +1,380 @@
+#pragma once
+
+#include <cib/tuple.hpp>
+#include <msg/field_matchers.hpp>
+#include <msg/match.hpp>
+#include <msg/message.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+namespace msg::detail {
+template <typename... Ts> struct type_list {};
+
+template <typename... Lists> struct concat {
+    using type = type_list<>;
+};
+
+template <typename... Ts> struct concat<type_list<Ts...>> {
+    using type = type_list<Ts...>;
+};
+
+template <typename... Ts, typename... Us, typename... Rest>
+struct concat<type_list<Ts...>, type_list<Us...>, Rest...>
+    : concat<type_list<Ts..., Us...>, Rest...> {};
+
+template <typename MsgType, typename AdditionalMatcher>
+using valid_msg_matcher_t = std::remove_cvref_t<
+    decltype(is_valid_msg_t<MsgType, AdditionalMatcher>::matcher)>;
+
+/**
+ * The fields that Matcher compares with fixed values through equal_to_t or
+ * in_t. These are the fields a handler can dispatch on.
+ */
+template <typename Matcher> struct keyed_fields {
+    using type = type_list<>;
+};
+
+template <typename Field, typename T, T Value>
+struct keyed_fields<equal_to_t<Field, T, Value>> {
+    using type = type_list<typename Field::FieldId>;
+};
+
+template <typename Field, typename T, T... Values>
+struct keyed_fields<in_t<Field, T, Values...>> {
+    using type = type_list<typename Field::FieldId>;
+};
+
+template <typename Op, typename... Matchers>
+struct keyed_fields<match::detail::logical_matcher<Op, Matchers...>>
+    : concat<typename keyed_fields<Matchers>::type...> {};
+
+template <typename MsgType, typename AdditionalMatcher>
+struct keyed_fields<is_valid_msg_t<MsgType, AdditionalMatcher>>
+    : keyed_fields<valid_msg_matcher_t<MsgType, AdditionalMatcher>> {};
+
+/**
+ * Decides whether a message whose Key field holds key could satisfy Matcher.
+ * An empty key stands for any value that no matcher compares Key with.
+ * Matchers that do not look at Key admit every key.
+ */
+template <typename Key, typename Matcher> struct key_filter {
+    [[nodiscard]] constexpr static auto admits(std::optional<std::uint64_t>)
+        -> bool {
+        return true;
+    }
+};
+
+template <typename Key> struct key_filter<Key, match::always_t<false>> {
+    [[nodiscard]] constexpr static auto admits(std::optional<std::uint64_t>)
+        -> bool {
+        return false;
+    }
+};
+
+template <typename Key, typename Field, typename T, T Value>
+    requires std::is_same_v<typename Field::FieldId, Key>
+struct key_filter<Key, equal_to_t<Field, T, Value>> {
+    [[nodiscard]] constexpr static auto
+    admits(std::optional<std::uint64_t> key) -> bool {
+        return key == static_cast<std::uint64_t>(Value);
+    }
+};
+
+template <typename Key, typename Field, typename T, T... Values>
+    requires std::is_same_v<typename Field::FieldId, Key>
+struct key_filter<Key, in_t<Field, T, Values...>> {
+    [[nodiscard]] constexpr static auto
+    admits(std::optional<std::uint64_t> key) -> bool {
+        return ((key == static_cast<std::uint64_t>(Values)) or ...);
+    }
+};
+
+template <typename Key, typename... Matchers>
+struct key_filter<Key, match::detail::logical_matcher<match::detail::all_op,
+                                                      Matchers...>> {
+    [[nodiscard]] constexpr static auto
+    admits(std::optional<std::uint64_t> key) -> bool {
+        return (key_filter<Key, Matchers>::admits(key) and ...);
+    }
+};
+
+template <typename Key, typename... Matchers>
+struct key_filter<Key, match::detail::logical_matcher<match::detail::any_op,
+                                                      Matchers...>> {
+    [[nodiscard]] constexpr static auto
+    admits(std::optional<std::uint64_t> key) -> bool {
+        return (key_filter<Key, Matchers>::admits(key) or ...);
+    }
+};
+
+template <typename Key, typename MsgType, typename AdditionalMatcher>
+struct key_filter<Key, is_valid_msg_t<MsgType, AdditionalMatcher>>
+    : key_filter<Key, valid_msg_matcher_t<MsgType, AdditionalMatcher>> {};
+
+/**
+ * The values Matcher compares its Key field with, written to out.
+ */
+template <typename Key, typename Matcher> struct key_values {
+    constexpr static std::size_t count = 0;
+
+    constexpr static auto copy(std::uint64_t *out) -> std::uint64_t * {
+        return out;
+    }
+};
+
+template <typename Key, typename Field, typename T, T... Values>
+    requires std::is_same_v<typename Field::FieldId, Key>
+struct key_values<Key, in_t<Field, T, Values...>> {
+    constexpr static std::size_t count = sizeof...(Values);
+
+    constexpr static auto copy(std::uint64_t *out) -> std::uint64_t * {
+        ((*out++ = static_cast<std::uint64_t>(Values)), ...);
+        return out;
+    }
+};
+
+template <typename Key, typename Field, typename T, T Value>
+    requires std::is_same_v<typename Field::FieldId, Key>
+struct key_values<Key, equal_to_t<Field, T, Value>>
+    : key_values<Key, in_t<Field, T, Value>> {};
+
+template <typename Key, typename Op, typename... Matchers>
+struct key_values<Key, match::detail::logical_matcher<Op, Matchers...>> {
+    constexpr static std::size_t count =
+        (std::size_t{} + ... + key_values<Key, Matchers>::count);
+
+    constexpr static auto copy(std::uint64_t *out) -> std::uint64_t * {
+        ((out = key_values<Key, Matchers>::copy(out)), ...);
+        return out;
+    }
+};
+
+template <typename Key, typename MsgType, typename AdditionalMatcher>
+struct key_values<Key, is_valid_msg_t<MsgType, AdditionalMatcher>>
+    : key_values<Key, valid_msg_matcher_t<MsgType, AdditionalMatcher>> {};
+
+/**
+ * The number of matchers that Key rules out for some messages.
+ */
+template <typename Key, typename... Matchers>
+constexpr auto key_score =
+    (std::size_t{} + ... +
+     (key_filter<Key, Matchers>::admits(std::nullopt) ? 0u : 1u));
+
+/**
+ * The keyed field that splits the matchers best: the one that rules out the
+ * most of them. void if no matcher compares a field with fixed values.
+ */
+template <typename Candidates, typename... Matchers> struct best_key;
+
+template <typename... Candidates, typename... Matchers>
+struct best_key<type_list<Candidates...>, Matchers...> {
+  private:
+    constexpr static auto best = [] {
+        std::array<std::size_t, sizeof...(Candidates)> scores{
+            key_score<Candidates, Matchers...>...};
+        auto i = std::size_t{};
+        for (auto j = std::size_t{}; j < scores.size(); ++j) {
+            if (scores[j] > scores[i]) {
+                i = j;
+            }
+        }
+        return i;
+    }();
+
+  public:
+    using type = std::tuple_element_t<best, std::tuple<Candidates...>>;
+};
+
+template <typename... Matchers> struct best_key<type_list<>, Matchers...> {
+    using type = void;
+};
+
+/**
+ * A constexpr table of which callbacks could claim a message, given the value
+ * of its Key field.
+ *
+ * The distinct values that the callbacks compare Key with are kept sorted.
+ * Each has a row listing the callbacks that require one of a few values of
+ * Key and accept this one. Callbacks that accept other values too are kept
+ * in a separate list, since they are candidates for every message. Finding
+ * the candidates for a message is a binary search, and only they need to be
+ * tried, in the order they were registered.
+ *
+ * @tparam Key The field to dispatch on.
+ * @tparam Matchers The matcher type of each callback, in registration order.
+ */
+template <typename Key, typename... Matchers> class dispatch_table {
+    constexpr static auto num_callbacks = sizeof...(Matchers);
+    constexpr static auto capacity =
+        (std::size_t{} + ... + key_values<Key, Matchers>::count);
+
+    template <typename Matcher>
+    constexpr static auto keyed =
+        not key_filter<Key, Matcher>::admits(std::nullopt);
+
+    std::array<std::uint64_t, capacity> keys{};
+    std::size_t num_keys{};
+    std::array<std::size_t, capacity + 1> row_offsets{};
+    std::array<std::size_t, capacity> rows{};
+    std::array<std::size_t, num_callbacks> unkeyed{};
+    std::size_t num_unkeyed{};
+
+    template <typename Matcher>
+    constexpr auto add_keyed(std::size_t i, std::size_t *row_ends) -> void {
+        if constexpr (keyed<Matcher>) {
+            for (auto k = std::size_t{}; k < num_keys; ++k) {
+                if (key_filter<Key, Matcher>::admits(keys[k])) {
+                    rows[row_ends[k]++] = i;
+                }
+            }
+        }
+    }
+
+    template <typename Matcher>
+    constexpr auto count_keyed(std::size_t *row_sizes) const -> void {
+        if constexpr (keyed<Matcher>) {
+            for (auto k = std::size_t{}; k < num_keys; ++k) {
+                if (key_filter<Key, Matcher>::admits(keys[k])) {
+                    ++row_sizes[k + 1];
+                }
+            }
+        }
+    }
+
+  public:
+    constexpr dispatch_table() {
+        auto out = keys.data();
+        ((out = key_values<Key, Matchers>::copy(out)), ...);
+        std::sort(keys.begin(), keys.end());
+        num_keys = static_cast<std::size_t>(
+            std::unique(keys.begin(), keys.end()) - keys.begin());
+
+        (count_keyed<Matchers>(row_offsets.data()), ...);
+        for (auto k = std::size_t{}; k < num_keys; ++k) {
+            row_offsets[k + 1] += row_offsets[k];
+        }
+
+        auto row_ends = row_offsets;
+        auto i = std::size_t{};
+        ((add_keyed<Matchers>(i++, row_ends.data())), ...);
+
+        i = 0;
+        (
+            [&] {
+                if constexpr (not keyed<Matchers>) {
+                    unkeyed[num_unkeyed++] = i;
+                }
+                ++i;
+            }(),
+            ...);
+    }
+
+    /**
+     * Try the callbacks that could claim a message whose Key field holds key,
+     * in registration order, until one does. An empty key means the message
+     * is too short to hold Key, and every callback is tried.
+     *
+     * @param try_callback
+     *      Called with the index of a callback, returning whether it claimed
+     *      the message.
+     *
+     * @return
+     *      Whether a callback claimed the message.
+     */
+    template <typename F>
+    constexpr auto dispatch(std::optional<std::uint64_t> key,
+                            F &&try_callback) const -> bool {
+        if (not key) {
+            for (auto i = std::size_t{}; i < num_callbacks; ++i) {
+                if (try_callback(i)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        auto const row = static_cast<std::size_t>(
+            std::lower_bound(keys.begin(), keys.begin() + num_keys, *key) -
+            keys.begin());
+        auto a = std::size_t{};
+        auto a_end = std::size_t{};
+        if (row < num_keys and keys[row] == *key) {
+            a = row_offsets[row];
+            a_end = row_offsets[row + 1];
+        }
+
+        auto b = std::size_t{};
+        while (a < a_end or b < num_unkeyed) {
+            auto const i = b == num_unkeyed or
+                                   (a < a_end and rows[a] < unkeyed[b])
+                               ? rows[a++]
+                               : unkeyed[b++];
+            if (try_callback(i)) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+template <typename Callback>
+using callback_matcher_t =
+    std::remove_cvref_t<decltype(std::declval<Callback const &>().matcher())>;
+
+/**
+ * How a handler dispatches to Callbacks: through a dispatch_table on the best
+ * keyed field, or, if no field rules out any callback, by trying every
+ * callback in turn.
+ */
+template <typename Callbacks> struct dispatch_for;
+
+template <typename... Callbacks> struct dispatch_for<cib::tuple<Callbacks...>> {
+    using key_t = typename best_key<
+        typename concat<typename keyed_fields<
+            callback_matcher_t<Callbacks>>::type...>::type,
+        callback_matcher_t<Callbacks>...>::type;
+
+    constexpr static auto indexed = [] {
+        if constexpr (std::is_void_v<key_t>) {
+            return false;
+        } else {
+            return key_score<key_t, callback_matcher_t<Callbacks>...> > 0;
+        }
+    }();
+};
+
+/**
+ * The dispatch_table of an indexed handler.
+ */
+template <typename Callbacks> struct dispatch_table_for;
+
+template <typename... Callbacks>
+struct dispatch_table_for<cib::tuple<Callbacks...>> {
+    using key_t = typename dispatch_for<cib::tuple<Callbacks...>>::key_t;
+
+    constexpr static auto table =
+        dispatch_table<key_t, callback_matcher_t<Callbacks>...>{};
+
+    /**
+     * @return
+     *      The value of the key field of msg, or nothing if msg is too short
+     *      to hold it.
+     */
+    template <typename Msg>
+    [[nodiscard]] constexpr static auto key_of(Msg const &msg)
+        -> std::optional<std::uint64_t> {
+        if (std::size(msg) <= key_t::MaxDWordExtent) {
+            return std::nullopt;
+        }
+        return static_cast<std::uint64_t>(key_t::extract(msg));
+    }
+};
+} // namespace msg::detail
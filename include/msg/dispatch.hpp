@@ -0,0 +1,41 @@
+#pragma once
+
+#include <utility>
+
+namespace msg {
+/**
+ * The concrete msg::handler that a nexus built for Service.
+ *
+ * cib::service<Service> is a handler_interface pointer, so calls through it
+ * are virtual. The nexus knows the concrete type of the handler, and calls
+ * made on the returned reference are direct and can be inlined.
+ *
+ * @tparam Service The msg::service to look up.
+ *
+ * @param nexus The cib::nexus that built the service.
+ */
+template <typename Service, typename Nexus>
+[[nodiscard]] constexpr auto handler_of([[maybe_unused]] Nexus const &nexus)
+    -> auto const & {
+    return Nexus::template service<Service>;
+}
+
+/**
+ * Handle msg with the handler of Service, calling it directly rather than
+ * through cib::service<Service>.
+ *
+ * <pre>
+ *   msg::dispatch<my_service>(nexus, msg);
+ * </pre>
+ *
+ * @tparam Service The msg::service to handle msg.
+ *
+ * @param nexus The cib::nexus that built the service.
+ * @param msg The message to handle.
+ * @param args The extra arguments of the service's callbacks.
+ */
+template <typename Service, typename Nexus, typename Msg, typename... Args>
+auto dispatch(Nexus const &nexus, Msg const &msg, Args &&...args) -> void {
+    handler_of<Service>(nexus).handle(msg, std::forward<Args>(args)...);
+}
+} // namespace msg
@@ -4,19 +4,76 @@
 #include <cib/tuple_algorithms.hpp>
 #include <log/log.hpp>
 #include <msg/callback.hpp>
+#include <msg/detail/dispatch_table.hpp>
 #include <msg/handler_interface.hpp>
 
 #include <array>
 #include <cstddef>
+#include <span>
 #include <type_traits>
+#include <utility>
 
 namespace msg {
 
+/**
+ * Dispatches messages to the first of its callbacks that claims them.
+ *
+ * When callbacks require fixed values of a common field, such as an opcode,
+ * the field that rules out the most callbacks is found at compile time and a
+ * message is only offered to the callbacks that accept its value of that
+ * field, looked up in a sorted table. Callbacks are still tried in the order
+ * they were registered, so the callback that claims a message is the same as
+ * if every callback were tried in turn.
+ */
 template <typename CallbacksT, typename BaseMsgT,
           typename... ExtraCallbackArgsT>
 struct handler : handler_interface<BaseMsgT, ExtraCallbackArgsT...> {
     CallbacksT callbacks{};
 
+  private:
+    using handle_fn = auto (*)(CallbacksT const &, BaseMsgT const &,
+                               ExtraCallbackArgsT...) -> bool;
+
+    template <std::size_t... Is>
+    constexpr static auto make_jump_table(std::index_sequence<Is...>) {
+        return std::array<handle_fn, sizeof...(Is)>{
+            [](CallbacksT const &cbs, BaseMsgT const &msg,
+               ExtraCallbackArgsT... args) -> bool {
+                return cbs[cib::index<Is>].handle(msg, args...);
+            }...};
+    }
+
+    constexpr static auto indexed = detail::dispatch_for<CallbacksT>::indexed;
+
+    auto try_callback(std::size_t i, BaseMsgT const &msg,
+                      ExtraCallbackArgsT... args) const -> bool {
+        constexpr static auto jump_table =
+            make_jump_table(std::make_index_sequence<CallbacksT::size()>{});
+        return jump_table[i](callbacks, msg, args...);
+    }
+
+    auto dispatch(BaseMsgT const &msg, ExtraCallbackArgsT... args) const
+        -> bool {
+        if constexpr (indexed) {
+            using dispatch_t = detail::dispatch_table_for<CallbacksT>;
+            return dispatch_t::table.dispatch(
+                dispatch_t::key_of(msg), [&](std::size_t i) {
+                    return try_callback(i, msg, args...);
+                });
+        } else {
+            return cib::any_of(
+                [&](auto &callback) { return callback.handle(msg, args...); },
+                callbacks);
+        }
+    }
+
+    auto report_unclaimed(BaseMsgT const &msg) const -> void {
+        CIB_ERROR("None of the registered callbacks claimed this message:");
+        cib::for_each([&](auto &callback) { callback.log_mismatch(msg); },
+                      callbacks);
+    }
+
+  public:
     constexpr explicit handler(CallbacksT new_callbacks)
         : callbacks{new_callbacks} {}
 
@@ -27,13 +84,20 @@ struct handler : handler_interface<BaseMsgT, ExtraCallbackArgsT...> {
     }
 
     void handle(BaseMsgT const &msg, ExtraCallbackArgsT... args) const final {
-        bool const found_valid_callback = cib::any_of(
-            [&](auto &callback) { return callback.handle(msg, args...); },
-            callbacks);
-        if (!found_valid_callback) {
-            CIB_ERROR("None of the registered callbacks claimed this message:");
-            cib::for_each([&](auto &callback) { callback.log_mismatch(msg); },
-                          callbacks);
+        if (not dispatch(msg, args...)) {
+            report_unclaimed(msg);
+        }
+    }
+
+    /**
+     * Handle each of msgs as handle() would, in the order they arrived, with
+     * one virtual call for the whole burst. A keyed handler finds the
+     * candidate callbacks of each message with one table lookup.
+     */
+    void handle_batch(std::span<BaseMsgT const> msgs,
+                      ExtraCallbackArgsT... args) const final {
+        for (auto const &msg : msgs) {
+            handle(msg, args...);
         }
     }
 };
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <span>
+
 namespace msg {
 template <typename MsgBaseT, typename... ExtraCallbackArgsT>
 struct handler_interface {
@@ -7,5 +9,16 @@ struct handler_interface {
 
     virtual void handle(MsgBaseT const &msg,
                         ExtraCallbackArgsT... extra_args) const = 0;
+
+    /**
+     * Handle a burst of messages with a single call, in the order they
+     * arrived. By default each message is passed to handle().
+     */
+    virtual void handle_batch(std::span<MsgBaseT const> msgs,
+                              ExtraCallbackArgsT... extra_args) const {
+        for (auto const &msg : msgs) {
+            handle(msg, extra_args...);
+        }
+    }
 };
 } // namespace msg
@@ -3,13 +3,18 @@
 #include <cib/tuple.hpp>
 #include <cib/tuple_algorithms.hpp>
 #include <container/vector.hpp>
+#include <log/log.hpp>
 #include <msg/field.hpp>
 #include <msg/match.hpp>
 #include <sc/fwd.hpp>
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <iterator>
+#include <memory>
+#include <span>
 #include <type_traits>
 
 namespace msg {
@@ -26,6 +31,11 @@ using iterator_t = decltype(std::begin(std::declval<T &>()));
 template <typename T, typename V>
 concept convertible_range_of =
     range<T> and std::convertible_to<std::iter_value_t<iterator_t<T>>, V>;
+
+template <typename T, typename V>
+concept contiguous_range_of =
+    range<T> and std::contiguous_iterator<iterator_t<T const>> and
+    std::same_as<std::iter_value_t<iterator_t<T const>>, V>;
 } // namespace detail
 
 template <std::uint32_t MaxNumDWords>
@@ -159,4 +169,81 @@ struct message_base : public message_data<MaxNumDWords> {
         return format("{}({})"_sc, name, middle_string);
     }
 };
+
+/**
+ * A message of type MsgType read in place from memory it does not own, such
+ * as a DMA buffer or a memory-mapped region.
+ *
+ * A message_view has the same get<Field>(), isValid() and describe() as
+ * MsgType, so matchers, msg::handler and callbacks accept it wherever they
+ * accept MsgType. Constructing one copies nothing: callbacks taking
+ * message_view<MsgType> see the received data itself. The viewed memory
+ * must outlive the view.
+ *
+ * @tparam MsgType The msg::message_base type to read the data as.
+ */
+template <typename MsgType> class message_view {
+    std::span<std::uint32_t const> dwords{};
+
+  public:
+    constexpr static auto name = MsgType::name;
+    constexpr static auto max_num_dwords = MsgType::max_num_dwords;
+    constexpr static auto match_valid_encoding = MsgType::match_valid_encoding;
+    using FieldTupleType = typename MsgType::FieldTupleType;
+
+    constexpr message_view() = default;
+
+    constexpr explicit message_view(std::span<std::uint32_t const> data)
+        : dwords{data} {}
+
+    template <detail::contiguous_range_of<std::uint32_t> R>
+    constexpr explicit message_view(R const &r)
+        : dwords{std::to_address(std::begin(r)), std::size(r)} {}
+
+    [[nodiscard]] constexpr auto isValid() const -> bool {
+        return match_valid_encoding(*this);
+    }
+
+    /**
+     * Read a field in place. Reading a field beyond the end of the viewed
+     * data is a fatal error, as it is for MsgType; the missing dwords read
+     * as zero.
+     */
+    template <typename FieldType> [[nodiscard]] constexpr auto get() const {
+        static_assert(MsgType::template is_valid_field<FieldType>());
+        FieldType::fits_inside(*this);
+        if (dwords.size() <= FieldType::MaxDWordExtent) {
+            CIB_FATAL("message view of {} dwords is too short to read dword "
+                      "{}",
+                      dwords.size(), FieldType::MaxDWordExtent);
+            std::array<std::uint32_t, max_num_dwords> padded{};
+            std::copy(dwords.begin(), dwords.end(), padded.begin());
+            return FieldType::extract(padded);
+        }
+        return FieldType::extract(dwords);
+    }
+
+    /**
+     * @return
+     *      The viewed data.
+     */
+    [[nodiscard]] constexpr auto data() const
+        -> std::span<std::uint32_t const> {
+        return dwords;
+    }
+
+    [[nodiscard]] constexpr auto describe() const {
+        auto const field_descriptions = cib::transform(
+            [&](auto field) {
+                using FieldType = decltype(field);
+                return FieldType{get<FieldType>()}.describe();
+            },
+            FieldTupleType{});
+
+        auto const middle_string = field_descriptions.join(
+            [](auto lhs, auto rhs) { return lhs + ", "_sc + rhs; });
+
+        return format("{}({})"_sc, name, middle_string);
+    }
+};
 } // namespace msg
@@ -2,6 +2,7 @@
 
 #include <cib/builder_meta.hpp>
 #include <cib/tuple.hpp>
+#include <msg/dispatch.hpp>
 #include <msg/handler_builder.hpp>
 #include <msg/handler_interface.hpp>
 
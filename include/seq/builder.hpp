@@ -4,7 +4,9 @@
 #include <flow/common.hpp>
 #include <flow/graph_builder.hpp>
 #include <seq/impl.hpp>
+#include <seq/parallel_impl.hpp>
 #include <seq/step.hpp>
+#include <seq/timed_impl.hpp>
 
 #include <cstddef>
 
@@ -15,8 +17,8 @@ namespace seq {
  *      seq::builder.
  *
  * @tparam EdgeCapacity
- *      The maximum number of dependencies from one action or milestone to
- *      another.
+ *      The average number of dependencies from each action or milestone to
+ *      another: the flow can hold NodeCapacity * EdgeCapacity dependencies.
  *
  * @see seq::impl
  * @see flow::graph_builder
@@ -29,6 +31,48 @@ struct builder
                           builder<Name, NodeCapacity, EdgeCapacity>> {
     template <typename N, std::size_t Capacity>
     using impl_t = seq::impl<N, Capacity>;
+
+    template <std::size_t Nodes, std::size_t Edges>
+    using rebind = builder<Name, Nodes, Edges>;
+};
+
+/**
+ * A seq::builder whose sequences poll the independent steps of each level
+ * together.
+ *
+ * @see seq::parallel_impl
+ * @see seq::builder
+ */
+template <typename Name = void, std::size_t NodeCapacity = 64,
+          std::size_t EdgeCapacity = 16>
+struct parallel_builder
+    : flow::graph_builder<step_base, Name, NodeCapacity, EdgeCapacity,
+                          parallel_builder<Name, NodeCapacity, EdgeCapacity>> {
+    template <typename N, std::size_t Capacity>
+    using impl_t = seq::parallel_impl<N, Capacity>;
+
+    template <std::size_t Nodes, std::size_t Edges>
+    using rebind = parallel_builder<Name, Nodes, Edges>;
+};
+
+/**
+ * A seq::builder whose sequences enforce step and sequence deadlines measured
+ * on Clock, rolling back when one expires.
+ *
+ * @see seq::timed_impl
+ * @see seq::builder
+ */
+template <typename Name, typename Clock, std::size_t NodeCapacity = 64,
+          std::size_t EdgeCapacity = 16>
+struct timed_builder
+    : flow::graph_builder<
+          step_base, Name, NodeCapacity, EdgeCapacity,
+          timed_builder<Name, Clock, NodeCapacity, EdgeCapacity>> {
+    template <typename N, std::size_t Capacity>
+    using impl_t = seq::timed_impl<N, Capacity, Clock>;
+
+    template <std::size_t Nodes, std::size_t Edges>
+    using rebind = timed_builder<Name, Clock, Nodes, Edges>;
 };
 
 /**
@@ -44,4 +88,28 @@ template <typename Name = void, std::size_t NodeCapacity = 64,
           std::size_t EdgeCapacity = 16>
 struct service : cib::builder_meta<builder<Name, NodeCapacity, EdgeCapacity>,
                                    flow::FunctionPtr> {};
+
+/**
+ * Extend this to create named seq services whose independent steps are
+ * polled together, a level at a time.
+ *
+ * @see seq::parallel_builder
+ */
+template <typename Name = void, std::size_t NodeCapacity = 64,
+          std::size_t EdgeCapacity = 16>
+struct parallel_service
+    : cib::builder_meta<parallel_builder<Name, NodeCapacity, EdgeCapacity>,
+                        flow::FunctionPtr> {};
+
+/**
+ * Extend this to create named seq services whose steps and runs have
+ * deadlines measured on Clock.
+ *
+ * @see seq::timed_builder
+ */
+template <typename Name, typename Clock, std::size_t NodeCapacity = 64,
+          std::size_t EdgeCapacity = 16>
+struct timed_service
+    : cib::builder_meta<timed_builder<Name, Clock, NodeCapacity, EdgeCapacity>,
+                        flow::FunctionPtr> {};
 } // namespace seq
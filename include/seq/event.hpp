@@ -0,0 +1,63 @@
+#pragma once
+
+#include <flow/common.hpp>
+#include <log/log.hpp>
+
+#include <concepts>
+#include <cstdint>
+
+namespace seq {
+/**
+ * Something a step can wait for, such as an interrupt, a timer expiring or a
+ * flag being set. Each event of a sequence needs a distinct id below 32.
+ */
+struct event {
+    std::uint8_t id;
+
+    constexpr explicit event(std::uint8_t i) : id{i} { CIB_ASSERT(id < 32); }
+
+    [[nodiscard]] constexpr auto mask() const -> std::uint32_t {
+        return std::uint32_t{1} << id;
+    }
+
+    [[nodiscard]] friend constexpr auto operator==(event, event)
+        -> bool = default;
+};
+
+/**
+ * What a step returns from one call: its status and, while it is not done,
+ * the events it is waiting for. A plain status converts to a result that
+ * waits for nothing.
+ */
+struct step_result {
+    flow::status value{};
+    std::uint32_t events{};
+
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    constexpr step_result(flow::status s, std::uint32_t e = 0)
+        : value{s}, events{e} {}
+
+    [[nodiscard]] friend constexpr auto operator==(step_result, step_result)
+        -> bool = default;
+};
+
+/**
+ * Return this from a step that cannot finish until one of es happens:
+ *
+ * <pre>
+ *   return rail_ready() ? seq::status::DONE : seq::wait_for(rail_good);
+ * </pre>
+ *
+ * The step must be declared to return seq::step_result. A seq::impl does not
+ * call it again until one of es is passed to its notify(). A step that
+ * returns a plain status::NOT_DONE is called again every time the sequence
+ * runs.
+ *
+ * @return
+ *      status::NOT_DONE, waiting for es
+ */
+template <std::same_as<event>... Es>
+[[nodiscard]] constexpr auto wait_for(event e, Es... es) -> step_result {
+    return {flow::status::NOT_DONE, (e.mask() | ... | es.mask())};
+}
+} // namespace seq
@@ -1,19 +1,51 @@
 #pragma once
 
 #include <flow/common.hpp>
+#include <seq/event.hpp>
+#include <seq/instrumentation.hpp>
 #include <seq/step.hpp>
 
 #include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <string_view>
 
 namespace seq {
 enum class direction { FORWARD = 0, BACKWARD = 1 };
 
-template <typename, std::size_t NumSteps> struct impl {
+/**
+ * seq::impl runs a sequence of steps forward and backward, one step at a
+ * time.
+ *
+ * A step may return seq::wait_for(event) instead of status::NOT_DONE. The
+ * sequence then leaves the step alone until the event is passed to
+ * notify(), so a main loop that calls forward() does not spin on it. The
+ * events travel back with the step's result, so sequences run on different
+ * threads or from interrupt handlers do not see each other's waits.
+ *
+ * A named sequence can be instrumented with seq::instrumentation::config, in
+ * which case the number of calls and the time each step takes to report
+ * status::DONE are added to histograms for each step and direction.
+ *
+ * @see seq::builder
+ */
+template <typename Name, std::size_t NumSteps> struct impl {
+    constexpr static bool instrumented =
+        instrumentation::is_enabled<Name>;
+
     std::array<func_ptr, NumSteps> _forward_steps{};
     std::array<func_ptr, NumSteps> _backward_steps{};
+    std::array<wait_func_ptr, NumSteps> _forward_waits{};
+    std::array<wait_func_ptr, NumSteps> _backward_waits{};
     std::size_t next_step{};
 
+    std::uint32_t waiting_for{};
+    std::atomic<std::uint32_t> fired{};
+
+    [[no_unique_address]] instrumentation::probe_type<Name> probe{};
+    std::array<std::string_view, instrumented ? NumSteps : 0> names{};
+
     status prev_status{status::DONE};
     direction prev_direction{direction::BACKWARD};
 
@@ -29,12 +61,71 @@ template <typename, std::size_t NumSteps> struct impl {
         for (auto i = std::size_t{}; i < NumSteps; i++) {
             _forward_steps[i] = steps[i]._forward_ptr;
             _backward_steps[i] = steps[i]._backward_ptr;
+            _forward_waits[i] = steps[i]._forward_wait_ptr;
+            _backward_waits[i] = steps[i]._backward_wait_ptr;
+            if constexpr (instrumented) {
+                names[i] = steps[i]._name;
+            }
         }
     }
 
   private:
+    /**
+     * @return
+     *      Whether the current step can be called: it is not waiting, or
+     *      one of the events it waits for has fired since it last ran.
+     */
+    constexpr auto ready() -> bool {
+        if (waiting_for == 0) {
+            return true;
+        }
+        auto const was_fired = fired.fetch_and(~waiting_for);
+        return (was_fired & waiting_for) != 0;
+    }
+
+    /**
+     * Call step i in direction dir, remembering the events it waits for if
+     * it is not done.
+     */
+    template <direction dir> constexpr auto call(std::size_t i) -> status {
+        auto const &steps =
+            dir == direction::FORWARD ? _forward_steps : _backward_steps;
+        auto const &waits =
+            dir == direction::FORWARD ? _forward_waits : _backward_waits;
+
+        auto const r = waits[i] != nullptr ? call_step<dir>(waits[i], i)
+                                           : call_step<dir>(steps[i], i);
+        waiting_for = r.value == status::NOT_DONE ? r.events : 0;
+        return r.value;
+    }
+
+    /**
+     * Call step i, and once it is done add what it took to the histograms of
+     * its direction.
+     */
+    template <direction dir, typename F>
+    constexpr auto call_step(F fn, std::size_t i) -> step_result {
+        if constexpr (instrumented) {
+            auto &histograms = instrumentation::storage<Name, NumSteps>;
+            instrumentation::results<Name> = {histograms.data(), names.data(),
+                                              NumSteps};
+            probe.poll();
+            auto const r = step_result{fn()};
+            if (r.value == status::DONE) {
+                probe.done(histograms[(i * 2) + static_cast<std::size_t>(dir)]);
+            }
+            return r;
+        } else {
+            return fn();
+        }
+    }
+
     constexpr auto step_forward() -> status {
-        if (_forward_steps[next_step]() == status::NOT_DONE) {
+        if (not ready()) {
+            return status::NOT_DONE;
+        }
+        auto const s = call<direction::FORWARD>(next_step);
+        if (s == status::NOT_DONE) {
             return status::NOT_DONE;
         }
         ++next_step;
@@ -42,7 +133,11 @@ template <typename, std::size_t NumSteps> struct impl {
     }
 
     constexpr auto step_backward() -> status {
-        if (_backward_steps[next_step - 1]() == status::NOT_DONE) {
+        if (not ready()) {
+            return status::NOT_DONE;
+        }
+        auto const s = call<direction::BACKWARD>(next_step - 1);
+        if (s == status::NOT_DONE) {
             return status::NOT_DONE;
         }
         --next_step;
@@ -101,6 +196,22 @@ template <typename, std::size_t NumSteps> struct impl {
   public:
     constexpr auto forward() -> status { return go<direction::FORWARD>(); }
     constexpr auto backward() -> status { return go<direction::BACKWARD>(); }
+
+    /**
+     * Record that e has happened, waking the step waiting for it. Events are
+     * latched, so notify() may be called from an interrupt handler and an
+     * event that fires while its step is running is not lost.
+     */
+    auto notify(event e) -> void { fired.fetch_or(e.mask()); }
+
+    /**
+     * @return
+     *      Whether the sequence is blocked on an event that has not fired, so
+     *      calling forward() or backward() would not make progress.
+     */
+    [[nodiscard]] auto is_waiting() const -> bool {
+        return waiting_for != 0 and (fired.load() & waiting_for) == 0;
+    }
 };
 
 template <typename Name> struct impl<Name, 0u> {
@@ -109,6 +220,8 @@ template <typename Name> struct impl<Name, 0u> {
 
     constexpr static auto forward() -> status { return status::DONE; }
     constexpr static auto backward() -> status { return status::DONE; }
+    constexpr static auto notify(event) -> void {}
+    [[nodiscard]] constexpr static auto is_waiting() -> bool { return false; }
 };
 
 } // namespace seq
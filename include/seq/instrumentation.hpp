@@ -0,0 +1,214 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace seq::instrumentation {
+/**
+ * The default instrumentation configuration: sequences are not instrumented.
+ */
+struct disabled {};
+
+/**
+ * Instrument every named sequence, timing steps with Clock.
+ *
+ * @tparam Clock
+ *      A type meeting the std::chrono Clock requirements.
+ *
+ * @tparam NumBuckets
+ *      The number of buckets in each histogram.
+ */
+template <typename Clock, std::size_t NumBuckets = 16> struct enabled {
+    static_assert(NumBuckets >= 2, "a histogram needs at least two buckets");
+    using clock = Clock;
+    constexpr static auto buckets = NumBuckets;
+};
+
+/**
+ * Programs select instrumentation by specializing this variable template, in
+ * the same way as flow::profiling::config:
+ *
+ * <pre>
+ *   template <>
+ *   inline auto seq::instrumentation::config<> =
+ *       seq::instrumentation::enabled<std::chrono::steady_clock>{};
+ * </pre>
+ *
+ * Left unspecialized, sequences are not instrumented.
+ */
+template <typename...> inline auto config = disabled{};
+
+/**
+ * A histogram with power-of-two buckets. Bucket 0 counts the value 0 and
+ * bucket k counts values in [2^(k-1), 2^k); the last bucket also counts every
+ * larger value.
+ */
+template <std::size_t NumBuckets> class log_histogram {
+    std::array<std::uint32_t, NumBuckets> counts{};
+
+  public:
+    [[nodiscard]] constexpr static auto bucket_of(std::uint64_t value)
+        -> std::size_t {
+        return std::min<std::size_t>(std::bit_width(value), NumBuckets - 1);
+    }
+
+    /**
+     * @return
+     *      The smallest value counted by bucket.
+     */
+    [[nodiscard]] constexpr static auto lower_bound(std::size_t bucket)
+        -> std::uint64_t {
+        return bucket == 0 ? 0 : std::uint64_t{1} << (bucket - 1);
+    }
+
+    constexpr auto add(std::uint64_t value) -> void {
+        ++counts[bucket_of(value)];
+    }
+
+    [[nodiscard]] constexpr static auto size() -> std::size_t {
+        return NumBuckets;
+    }
+
+    [[nodiscard]] constexpr auto operator[](std::size_t bucket) const
+        -> std::uint32_t {
+        return counts[bucket];
+    }
+
+    /**
+     * @return
+     *      The number of values added.
+     */
+    [[nodiscard]] constexpr auto total() const -> std::uint64_t {
+        auto sum = std::uint64_t{};
+        for (auto const c : counts) {
+            sum += c;
+        }
+        return sum;
+    }
+};
+
+/**
+ * What it took one step to report status::DONE in one direction: how many
+ * times it was called, and how many ticks of the clock passed from its first
+ * call until it was done.
+ */
+template <std::size_t NumBuckets> struct step_histograms {
+    log_histogram<NumBuckets> polls{};
+    log_histogram<NumBuckets> ticks{};
+};
+
+/**
+ * Tracks the step a sequence is currently working on.
+ */
+template <typename Clock> struct probe {
+    typename Clock::time_point started{};
+    std::uint64_t polls{};
+
+    auto poll() -> void {
+        if (polls++ == 0) {
+            started = Clock::now();
+        }
+    }
+
+    template <std::size_t NumBuckets>
+    auto done(step_histograms<NumBuckets> &h) -> void {
+        h.polls.add(polls);
+        h.ticks.add(
+            static_cast<std::uint64_t>((Clock::now() - started).count()));
+        polls = 0;
+    }
+};
+
+struct no_probe {};
+
+namespace detail {
+template <typename Name, typename Config> struct select {
+    constexpr static bool enabled = false;
+    constexpr static std::size_t buckets = 0;
+    using probe_t = no_probe;
+};
+
+template <typename Name, typename Clock, std::size_t NumBuckets>
+    requires(not std::is_void_v<Name>)
+struct select<Name, enabled<Clock, NumBuckets>> {
+    constexpr static bool enabled = true;
+    constexpr static std::size_t buckets = NumBuckets;
+    using probe_t = probe<Clock>;
+};
+
+template <typename Name, typename... Ts>
+struct traits : select<Name, std::remove_cvref_t<decltype(config<Ts...>)>> {};
+} // namespace detail
+
+/**
+ * Whether the sequence named Name is instrumented. Only named sequences are
+ * instrumented, since the results are looked up by name.
+ */
+template <typename Name, typename... Ts>
+constexpr static bool is_enabled = detail::traits<Name, Ts...>::enabled;
+
+template <typename Name, typename... Ts>
+using probe_type = typename detail::traits<Name, Ts...>::probe_t;
+
+template <typename Name, typename... Ts>
+using histograms_type =
+    step_histograms<detail::traits<Name, Ts...>::buckets>;
+
+/**
+ * A view of the histograms gathered for every step of one sequence.
+ */
+template <typename Histograms> class results_view {
+    Histograms const *steps{};
+    std::string_view const *step_names{};
+    std::size_t num_steps{};
+
+  public:
+    constexpr results_view() = default;
+
+    constexpr results_view(Histograms const *s, std::string_view const *n,
+                           std::size_t size)
+        : steps{s}, step_names{n}, num_steps{size} {}
+
+    /**
+     * @return
+     *      The number of steps, or zero if the sequence has not run yet.
+     */
+    [[nodiscard]] constexpr auto size() const -> std::size_t {
+        return num_steps;
+    }
+
+    [[nodiscard]] constexpr auto forward(std::size_t i) const
+        -> Histograms const & {
+        return steps[i * 2];
+    }
+
+    [[nodiscard]] constexpr auto backward(std::size_t i) const
+        -> Histograms const & {
+        return steps[(i * 2) + 1];
+    }
+
+    [[nodiscard]] constexpr auto name(std::size_t i) const
+        -> std::string_view {
+        return step_names[i];
+    }
+};
+
+/**
+ * The forward and backward histograms of every step of each seq::impl, in
+ * sequence order.
+ */
+template <typename Name, std::size_t NumSteps, typename... Ts>
+inline std::array<histograms_type<Name, Ts...>, NumSteps * 2> storage{};
+
+/**
+ * The instrumentation results of the sequence named Name. Results become
+ * available once the sequence has run for the first time.
+ */
+template <typename Name, typename... Ts>
+inline results_view<histograms_type<Name, Ts...>> results{};
+} // namespace seq::instrumentation
@@ -0,0 +1,225 @@
+#pragma once
+
+#include <flow/common.hpp>
+#include <flow/detail/bitset.hpp>
+#include <flow/reachability.hpp>
+#include <seq/impl.hpp>
+#include <seq/step.hpp>
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace seq {
+/**
+ * seq::parallel_impl runs a sequence one level at a time instead of one step
+ * at a time.
+ *
+ * Steps that share a level do not depend on each other, so all of them are
+ * polled on every call and the sequence moves on to the next level only
+ * once the whole group reports status::DONE. A slow step then holds up the
+ * steps after it, but not the independent steps beside it. Going backward,
+ * the levels are undone in reverse order in the same way.
+ *
+ * As with seq::impl, changing direction while a group is in progress first
+ * finishes that group in the direction it was going.
+ *
+ * The builder also tells the sequence which steps depend on which, so that
+ * part of it can be rolled back with roll_back(): only the given steps and
+ * the steps that depend on them are undone, and the rest stay done. The
+ * minimal set of steps to undo for each step is worked out at compile time.
+ *
+ * @see seq::parallel_builder
+ */
+template <typename, std::size_t NumSteps> struct parallel_impl {
+    using step_set = flow::detail::bitset<NumSteps>;
+
+    std::array<func_ptr, NumSteps> _forward_steps{};
+    std::array<func_ptr, NumSteps> _backward_steps{};
+    std::array<std::string_view, NumSteps> _names{};
+    std::array<std::size_t, NumSteps + 1> level_offsets{};
+    flow::reachability<NumSteps> dependents{};
+    std::size_t num_levels{};
+    std::size_t active_level{};
+    step_set done{};
+    step_set rolling_back{};
+
+    status prev_status{status::DONE};
+    direction prev_direction{direction::BACKWARD};
+
+    template <std::size_t Capacity>
+    constexpr parallel_impl(step_base const *steps, std::size_t const *levels,
+                            flow::reachability<Capacity> const &reach,
+                            flow::build_status) {
+        for (auto i = std::size_t{}; i < NumSteps; i++) {
+            _forward_steps[i] = steps[i]._forward_ptr;
+            _backward_steps[i] = steps[i]._backward_ptr;
+            _names[i] = steps[i]._name;
+
+            if (i == 0 or levels[i] != levels[i - 1]) {
+                level_offsets[num_levels++] = i;
+            }
+            reach.for_each_dependent(
+                i, [&](std::size_t j) { dependents.add(i, j); });
+        }
+        level_offsets[num_levels] = NumSteps;
+    }
+
+  private:
+    /**
+     * Poll the steps of one level that still need to go in direction dir.
+     */
+    template <direction dir> constexpr auto step(std::size_t level) -> status {
+        auto const first = level_offsets[level];
+        auto const last = level_offsets[level + 1];
+        active_level = level;
+
+        auto pending = false;
+        for (auto n = std::size_t{}; n < last - first; n++) {
+            auto const i =
+                dir == direction::FORWARD ? first + n : last - 1 - n;
+            if (done.contains(i) == (dir == direction::FORWARD)) {
+                continue;
+            }
+
+            if constexpr (dir == direction::FORWARD) {
+                if (_forward_steps[i]() == status::DONE) {
+                    done.insert(i);
+                    continue;
+                }
+            } else {
+                if (_backward_steps[i]() == status::DONE) {
+                    done.erase(i);
+                    continue;
+                }
+            }
+            pending = true;
+        }
+        return pending ? status::NOT_DONE : status::DONE;
+    }
+
+    /**
+     * Poll the backward step of every step being rolled back whose
+     * dependents have all been undone. Steps are visited latest first, so a
+     * step can be undone in the same call as the steps that depend on it.
+     */
+    constexpr auto unwind() -> status {
+        for (auto n = NumSteps; n > 0; n--) {
+            auto const i = n - 1;
+            if (not rolling_back.contains(i) or not done.contains(i) or
+                dependents.dependents_of(i).intersects(done)) {
+                continue;
+            }
+            if (_backward_steps[i]() == status::DONE) {
+                done.erase(i);
+            }
+        }
+
+        if (rolling_back.intersects(done)) {
+            return status::NOT_DONE;
+        }
+        rolling_back = {};
+        return status::DONE;
+    }
+
+    template <direction dir> constexpr auto go() -> status {
+        constexpr direction opposite_dir = dir == direction::FORWARD
+                                               ? direction::BACKWARD
+                                               : direction::FORWARD;
+
+        if (not rolling_back.empty() and unwind() == status::NOT_DONE) {
+            return status::NOT_DONE;
+        }
+
+        // check if previous direction has finished or not
+        if (prev_direction == opposite_dir && prev_status == status::NOT_DONE &&
+            step<opposite_dir>(active_level) == status::NOT_DONE) {
+            return status::NOT_DONE;
+        }
+
+        prev_direction = dir;
+
+        // proceed in the requested direction
+        for (auto n = std::size_t{}; n < num_levels; n++) {
+            auto const level =
+                dir == direction::FORWARD ? n : num_levels - 1 - n;
+            if (step<dir>(level) == status::NOT_DONE) {
+                prev_status = status::NOT_DONE;
+                return status::NOT_DONE;
+            }
+        }
+
+        prev_status = status::DONE;
+        return status::DONE;
+    }
+
+  public:
+    constexpr auto forward() -> status { return go<direction::FORWARD>(); }
+    constexpr auto backward() -> status { return go<direction::BACKWARD>(); }
+
+    /**
+     * @return
+     *      The position of step in the sorted sequence, or NumSteps if it is
+     *      not part of it. Steps are told apart by name as well as by their
+     *      functions, so steps that share a function keep their own
+     *      positions.
+     */
+    [[nodiscard]] constexpr auto index_of(step_base const &s) const
+        -> std::size_t {
+        for (auto i = std::size_t{}; i < NumSteps; i++) {
+            if (_names[i] == s._name and
+                _forward_steps[i] == s._forward_ptr and
+                _backward_steps[i] == s._backward_ptr) {
+                return i;
+            }
+        }
+        return NumSteps;
+    }
+
+    /**
+     * @return
+     *      The steps that must be undone to undo the step at index i: the
+     *      step itself and every step that depends on it, directly or
+     *      through other steps.
+     */
+    [[nodiscard]] constexpr auto rollback_set(std::size_t i) const
+        -> step_set {
+        return dependents.dependents_of(i).with(i);
+    }
+
+    /**
+     * Undo the given steps and the steps that depend on them, leaving every
+     * other step as it is. Backward steps that do not depend on each other
+     * are polled together, and a step is undone only once everything that
+     * depends on it has been. Steps that are not done are skipped.
+     *
+     * A group in progress is first finished in the direction it was going,
+     * and a rollback in progress is finished before the sequence runs in
+     * either direction again.
+     *
+     * @return
+     *      status::DONE once every step to undo has been undone.
+     */
+    template <typename... Steps>
+    constexpr auto roll_back(Steps const &...steps) -> status {
+        if (prev_status == status::NOT_DONE) {
+            auto const s = prev_direction == direction::FORWARD
+                               ? step<direction::FORWARD>(active_level)
+                               : step<direction::BACKWARD>(active_level);
+            if (s == status::NOT_DONE) {
+                return status::NOT_DONE;
+            }
+            prev_status = status::DONE;
+        }
+
+        (
+            [&](std::size_t i) {
+                if (i < NumSteps) {
+                    rolling_back |= rollback_set(i);
+                }
+            }(index_of(steps)),
+            ...);
+        return unwind();
+    }
+};
+} // namespace seq
@@ -1,36 +1,104 @@
 #pragma once
 
+#include <flow/common.hpp>
 #include <flow/detail/dependency.hpp>
 #include <flow/detail/parallel.hpp>
+#include <seq/event.hpp>
 
+#include <chrono>
+#include <concepts>
 #include <cstddef>
+#include <string_view>
+#include <type_traits>
 
 namespace seq {
-enum class status { NOT_DONE = 0, DONE = 1 };
+using flow::status;
 
 using func_ptr = auto (*)() -> status;
+using wait_func_ptr = auto (*)() -> step_result;
 using log_func_ptr = auto (*)() -> void;
 
+/**
+ * A stateless callable that a step can be made from: it returns a status,
+ * or a step_result naming the events it waits for.
+ */
+template <typename F>
+concept step_function =
+    std::is_empty_v<F> and std::default_initializable<F> and
+    requires(F const &f) {
+        { f() } -> std::convertible_to<step_result>;
+    };
+
+/**
+ * A step_function that may wait for events.
+ */
+template <typename F>
+concept waiting_step_function = step_function<F> and requires(F const &f) {
+    { f() } -> std::same_as<step_result>;
+};
+
+namespace detail {
+template <step_function F> constexpr auto poll_ptr() -> func_ptr {
+    return [] { return step_result{F{}()}.value; };
+}
+
+template <step_function F> constexpr auto wait_ptr() -> wait_func_ptr {
+    return [] { return step_result{F{}()}; };
+}
+} // namespace detail
+
 class step_base {
   private:
     func_ptr _forward_ptr{};
     func_ptr _backward_ptr{};
+    wait_func_ptr _forward_wait_ptr{};
+    wait_func_ptr _backward_wait_ptr{};
     log_func_ptr log_name{};
+    std::string_view _name{};
+    std::chrono::microseconds _timeout{};
 
     template <typename, std::size_t NumSteps> friend struct impl;
+    template <typename, std::size_t NumSteps> friend struct parallel_impl;
+    template <typename, std::size_t NumSteps, typename Clock>
+    friend struct timed_impl;
 
   public:
     template <typename Name>
     constexpr step_base([[maybe_unused]] Name name, func_ptr forward_ptr,
                         func_ptr backward_ptr)
         : _forward_ptr{forward_ptr}, _backward_ptr{backward_ptr},
-          log_name{[]() { CIB_TRACE("seq.step({})", Name{}); }} {}
+          log_name{[]() { CIB_TRACE("seq.step({})", Name{}); }},
+          _name{Name::value} {}
+
+    template <typename Name>
+    constexpr step_base(Name name, func_ptr forward_ptr, func_ptr backward_ptr,
+                        std::chrono::microseconds timeout)
+        : step_base{name, forward_ptr, backward_ptr} {
+        _timeout = timeout;
+    }
+
+    template <typename Name, step_function F, step_function B>
+    constexpr step_base(Name name, F, B,
+                        std::chrono::microseconds timeout = {})
+        : step_base{name, detail::poll_ptr<F>(), detail::poll_ptr<B>(),
+                    timeout} {
+        _forward_wait_ptr = detail::wait_ptr<F>();
+        _backward_wait_ptr = detail::wait_ptr<B>();
+    }
 
     constexpr step_base() = default;
 
     constexpr void forward() const { _forward_ptr(); }
     constexpr void backward() const { _backward_ptr(); }
 
+    /**
+     * @return
+     *      The name given to this step.
+     */
+    [[nodiscard]] constexpr auto get_name() const -> std::string_view {
+        return _name;
+    }
+
   private:
     [[nodiscard]] constexpr friend auto operator==(step_base const &lhs,
                                                    step_base const &rhs)
@@ -61,4 +129,48 @@ template <typename NameType>
                                   func_ptr backward) -> step_base {
     return {name, forward, backward};
 }
+
+/**
+ * @param timeout
+ *      How long the step may keep returning status::NOT_DONE, in either
+ *      direction, before a seq::timed_impl gives up on it. Other sequencers
+ *      ignore it.
+ *
+ * @return
+ *      New step with a deadline.
+ */
+template <typename NameType>
+[[nodiscard]] constexpr auto step(NameType name, func_ptr forward,
+                                  func_ptr backward,
+                                  std::chrono::microseconds timeout)
+    -> step_base {
+    return {name, forward, backward, timeout};
+}
+
+/**
+ * @param forward
+ *      A stateless callable that may return seq::wait_for(event).
+ *
+ * @return
+ *      New step that a seq::impl leaves alone while it waits for an event.
+ *      Other sequencers poll it like any other step.
+ */
+template <typename NameType, step_function F, step_function B>
+    requires(waiting_step_function<F> or waiting_step_function<B>)
+[[nodiscard]] constexpr auto step(NameType name, F forward, B backward)
+    -> step_base {
+    return {name, forward, backward};
+}
+
+/**
+ * @return
+ *      New step that may wait for events and has a deadline.
+ */
+template <typename NameType, step_function F, step_function B>
+    requires(waiting_step_function<F> or waiting_step_function<B>)
+[[nodiscard]] constexpr auto step(NameType name, F forward, B backward,
+                                  std::chrono::microseconds timeout)
+    -> step_base {
+    return {name, forward, backward, timeout};
+}
 } // namespace seq
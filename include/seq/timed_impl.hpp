@@ -0,0 +1,278 @@
+#pragma once
+
+#include <flow/common.hpp>
+#include <seq/impl.hpp>
+#include <seq/step.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+namespace seq {
+/**
+ * The result of one call to seq::timed_impl::forward() or backward().
+ * TIMED_OUT means a deadline expired and the sequence has rolled back.
+ */
+enum class timed_status { NOT_DONE = 0, DONE = 1, TIMED_OUT = 2 };
+
+/**
+ * seq::timed_impl is a sequence whose steps and whole forward run can be
+ * given deadlines.
+ *
+ * It runs like seq::impl, one step at a time. In addition, a step made with
+ * a timeout is abandoned once it has kept returning status::NOT_DONE for
+ * longer than its timeout, and a forward run is abandoned once it has taken
+ * longer than the timeout set with set_timeout(). When a forward step is
+ * abandoned, the sequence rolls back: the backward step of the abandoned
+ * step and then of every completed step runs, latest first. After the
+ * rollback, forward() returns timed_status::TIMED_OUT and timed_out_step()
+ * names the step that overran.
+ *
+ * A backward step that overruns its own timeout is abandoned too and the
+ * rollback carries on with the step before it, so that recovery takes a
+ * bounded time even when an undo hangs.
+ *
+ * @tparam Clock
+ *      A std::chrono Clock used to measure elapsed time.
+ *
+ * @see seq::timed_builder
+ */
+template <typename, std::size_t NumSteps, typename Clock> struct timed_impl {
+    using duration = typename Clock::duration;
+    using time_point = typename Clock::time_point;
+
+    std::array<func_ptr, NumSteps> _forward_steps{};
+    std::array<func_ptr, NumSteps> _backward_steps{};
+    std::array<duration, NumSteps> _timeouts{};
+    std::array<std::string_view, NumSteps> _names{};
+    std::size_t next_step{};
+
+    status prev_status{status::DONE};
+    direction prev_direction{direction::BACKWARD};
+
+    duration sequence_timeout{};
+    time_point sequence_started{};
+    time_point step_started{};
+    bool step_in_progress{};
+    bool rolling_back{};
+    std::optional<std::size_t> overrun{};
+
+    constexpr timed_impl(step_base const *steps, flow::build_status) {
+        for (auto i = std::size_t{}; i < NumSteps; i++) {
+            _forward_steps[i] = steps[i]._forward_ptr;
+            _backward_steps[i] = steps[i]._backward_ptr;
+            _timeouts[i] = std::chrono::ceil<duration>(steps[i]._timeout);
+            _names[i] = steps[i]._name;
+        }
+    }
+
+  private:
+    [[nodiscard]] auto overran(std::size_t i, direction dir) const -> bool {
+        auto const now = Clock::now();
+        if (_timeouts[i] != duration::zero() and
+            now - step_started >= _timeouts[i]) {
+            return true;
+        }
+        return dir == direction::FORWARD and
+               sequence_timeout != duration::zero() and
+               now - sequence_started >= sequence_timeout;
+    }
+
+    /**
+     * Poll the current step once.
+     *
+     * @return
+     *      timed_status::TIMED_OUT if the step is still not done and has
+     *      overrun.
+     */
+    template <direction dir> auto step() -> timed_status {
+        auto const i = dir == direction::FORWARD ? next_step : next_step - 1;
+        if (not step_in_progress) {
+            step_started = Clock::now();
+            step_in_progress = true;
+        }
+
+        auto const s = dir == direction::FORWARD ? _forward_steps[i]()
+                                                 : _backward_steps[i]();
+        if (s == status::DONE) {
+            step_in_progress = false;
+            if constexpr (dir == direction::FORWARD) {
+                ++next_step;
+            } else {
+                --next_step;
+            }
+            return timed_status::DONE;
+        }
+        return overran(i, dir) ? timed_status::TIMED_OUT
+                               : timed_status::NOT_DONE;
+    }
+
+    /**
+     * Poll the current backward step once, moving past it if it overruns.
+     */
+    auto step_backward() -> status {
+        auto const s = step<direction::BACKWARD>();
+        if (s == timed_status::TIMED_OUT) {
+            if (not overrun) {
+                overrun = next_step - 1;
+            }
+            step_in_progress = false;
+            --next_step;
+            return status::DONE;
+        }
+        return s == timed_status::DONE ? status::DONE : status::NOT_DONE;
+    }
+
+    /**
+     * Undo steps until the sequence is back at its start.
+     */
+    auto unwind() -> status {
+        prev_direction = direction::BACKWARD;
+        while (next_step > 0) {
+            if (step_backward() == status::NOT_DONE) {
+                prev_status = status::NOT_DONE;
+                return status::NOT_DONE;
+            }
+        }
+        prev_status = status::DONE;
+        return status::DONE;
+    }
+
+    /**
+     * Give up on the forward step that overran and start rolling back,
+     * beginning with that step's own backward step.
+     */
+    auto abandon_forward() -> status {
+        overrun = next_step;
+        step_in_progress = false;
+        ++next_step;
+        rolling_back = true;
+        return roll_back();
+    }
+
+    constexpr static auto to_timed(status s) -> timed_status {
+        return s == status::DONE ? timed_status::DONE : timed_status::NOT_DONE;
+    }
+
+    auto roll_back() -> status {
+        if (unwind() == status::NOT_DONE) {
+            return status::NOT_DONE;
+        }
+        rolling_back = false;
+        return status::DONE;
+    }
+
+  public:
+    /**
+     * Run the sequence forward until a step is not yet done.
+     *
+     * @return
+     *      timed_status::TIMED_OUT once a deadline has expired and the
+     *      sequence has rolled back; timed_status::NOT_DONE while a step or
+     *      the rollback is in progress.
+     */
+    auto forward() -> timed_status {
+        if (rolling_back) {
+            return roll_back() == status::DONE ? timed_status::TIMED_OUT
+                                               : timed_status::NOT_DONE;
+        }
+
+        // check if previous direction has finished or not
+        if (prev_direction == direction::BACKWARD &&
+            prev_status == status::NOT_DONE &&
+            step_backward() == status::NOT_DONE) {
+            return timed_status::NOT_DONE;
+        }
+
+        if (prev_direction != direction::FORWARD or
+            prev_status != status::NOT_DONE) {
+            sequence_started = Clock::now();
+            overrun.reset();
+        }
+        prev_direction = direction::FORWARD;
+
+        // proceed in the requested direction
+        while (next_step < NumSteps) {
+            auto const s = step<direction::FORWARD>();
+            if (s == timed_status::NOT_DONE) {
+                prev_status = status::NOT_DONE;
+                return timed_status::NOT_DONE;
+            }
+            if (s == timed_status::TIMED_OUT) {
+                return abandon_forward() == status::DONE
+                           ? timed_status::TIMED_OUT
+                           : timed_status::NOT_DONE;
+            }
+        }
+
+        prev_status = status::DONE;
+        return timed_status::DONE;
+    }
+
+    /**
+     * Run the sequence backward until a step is not yet done. Backward steps
+     * that overrun are abandoned.
+     */
+    auto backward() -> timed_status {
+        if (rolling_back) {
+            return to_timed(roll_back());
+        }
+
+        // check if previous direction has finished or not
+        if (prev_direction == direction::FORWARD &&
+            prev_status == status::NOT_DONE) {
+            auto const s = step<direction::FORWARD>();
+            if (s == timed_status::NOT_DONE) {
+                return timed_status::NOT_DONE;
+            }
+            if (s == timed_status::TIMED_OUT) {
+                return to_timed(abandon_forward());
+            }
+        }
+
+        return to_timed(unwind());
+    }
+
+    /**
+     * Set a deadline for each forward run of the whole sequence, measured
+     * from the first call to forward(). A zero timeout, the default, means
+     * no deadline.
+     */
+    auto set_timeout(duration timeout) -> void { sequence_timeout = timeout; }
+
+    /**
+     * @return
+     *      The index of the step that overran during the last run, if any.
+     */
+    [[nodiscard]] auto timed_out_step() const -> std::optional<std::size_t> {
+        return overrun;
+    }
+
+    /**
+     * @return
+     *      The name of the step at index i.
+     */
+    [[nodiscard]] constexpr auto step_name(std::size_t i) const
+        -> std::string_view {
+        return _names[i];
+    }
+};
+
+template <typename Name, typename Clock> struct timed_impl<Name, 0u, Clock> {
+    constexpr timed_impl(step_base const *, flow::build_status) noexcept {}
+
+    constexpr static auto forward() -> timed_status {
+        return timed_status::DONE;
+    }
+    constexpr static auto backward() -> timed_status {
+        return timed_status::DONE;
+    }
+    constexpr static auto set_timeout(typename Clock::duration) -> void {}
+    [[nodiscard]] constexpr static auto timed_out_step()
+        -> std::optional<std::size_t> {
+        return {};
+    }
+};
+} // namespace seq
@@ -0,0 +1,94 @@
+#include <flow/flow.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+namespace {
+auto actual = std::string("");
+bool feature_enabled{};
+int checks{};
+
+constexpr auto feature = [] {
+    ++checks;
+    return feature_enabled;
+};
+
+constexpr auto a = flow::action("a"_sc, [] { actual += "a"; });
+constexpr auto b = flow::action("b"_sc, [] { actual += "b"; });
+constexpr auto x = flow::action_if("x"_sc, feature, [] { actual += "x"; });
+constexpr auto y = flow::action_if("y"_sc, feature, [] { actual += "y"; });
+
+TEST_CASE("guarded action runs only when its predicate holds",
+          "[action_if]") {
+    flow::builder<> builder;
+    builder.add(a >> x >> b);
+    auto const flow = builder.topo_sort<flow::impl, 3>();
+
+    actual = "";
+    feature_enabled = false;
+    flow();
+    REQUIRE(actual == "ab");
+
+    actual = "";
+    feature_enabled = true;
+    flow();
+    REQUIRE(actual == "axb");
+}
+
+TEST_CASE("actions sharing a guard are checked once", "[action_if]") {
+    flow::builder<> builder;
+    builder.add(a && x && b && y);
+    auto const flow = builder.topo_sort<flow::impl, 4>();
+
+    actual = "";
+    checks = 0;
+    feature_enabled = true;
+    flow();
+    REQUIRE(checks == 1);
+    REQUIRE(actual.size() == 4);
+
+    actual = "";
+    checks = 0;
+    feature_enabled = false;
+    flow();
+    REQUIRE(checks == 1);
+    REQUIRE(actual == "ab");
+}
+
+TEST_CASE("guarded segments continue across levels", "[action_if]") {
+    flow::builder<> builder;
+    builder.add((a && x) >> (y && b));
+    auto const flow = builder.topo_sort<flow::impl, 4>();
+
+    actual = "";
+    checks = 0;
+    feature_enabled = true;
+    flow();
+    REQUIRE(checks == 1);
+    REQUIRE(actual == "axyb");
+}
+
+TEST_CASE("guarded action runs in other flow types", "[action_if]") {
+    flow::parallel_builder<> parallel;
+    parallel.add(a >> x);
+    auto const parallel_flow =
+        parallel.topo_sort<flow::parallel_impl, 2>();
+
+    flow::inline_builder<> inlined;
+    inlined.add(a >> x);
+    auto const inline_flow = inlined.topo_sort<flow::inline_impl, 2>();
+
+    actual = "";
+    feature_enabled = false;
+    parallel_flow();
+    inline_flow();
+    REQUIRE(actual == "aa");
+
+    actual = "";
+    feature_enabled = true;
+    parallel_flow();
+    inline_flow();
+    REQUIRE(actual == "axax");
+}
+} // namespace
@@ -0,0 +1,142 @@
+#include <cib/cib.hpp>
+#include <flow/flow.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+namespace {
+auto actual = std::string("");
+int disk_polls{};
+int net_polls{};
+
+constexpr auto a = flow::action("a"_sc, [] { actual += "a"; });
+constexpr auto b = flow::action("b"_sc, [] { actual += "b"; });
+constexpr auto c = flow::action("c"_sc, [] { actual += "c"; });
+
+constexpr auto disk = flow::async_action("disk"_sc, [] {
+    actual += "d";
+    return ++disk_polls < 3 ? flow::status::NOT_DONE : flow::status::DONE;
+});
+
+constexpr auto net = flow::async_action("net"_sc, [] {
+    actual += "n";
+    return ++net_polls < 2 ? flow::status::NOT_DONE : flow::status::DONE;
+});
+
+auto reset() -> void {
+    actual = "";
+    disk_polls = 0;
+    net_polls = 0;
+}
+
+TEST_CASE("build and run empty async flow", "[async_flow]") {
+    flow::async_builder<> builder;
+    auto const flow = builder.topo_sort<flow::async_impl, 0>();
+    decltype(flow)::cursor cur{};
+    REQUIRE(flow.poll(cur) == flow::status::DONE);
+}
+
+TEST_CASE("pending actions of a level overlap", "[async_flow]") {
+    flow::async_builder<> builder;
+    builder.add(a >> (disk && net) >> b);
+    auto const flow = builder.topo_sort<flow::async_impl, 4>();
+
+    reset();
+    decltype(flow)::cursor cur{};
+    REQUIRE(flow.poll(cur) == flow::status::NOT_DONE);
+    REQUIRE(flow.poll(cur) == flow::status::NOT_DONE);
+    REQUIRE(flow.poll(cur) == flow::status::DONE);
+
+    REQUIRE(flow.getNumLevels() == 3);
+    REQUIRE(actual == "adndndb");
+}
+
+TEST_CASE("a pending action holds up only its dependents", "[async_flow]") {
+    flow::async_builder<> builder;
+    builder.add(disk >> a);
+    builder.add(b >> c);
+    auto const flow = builder.topo_sort<flow::async_impl, 4>();
+
+    reset();
+    decltype(flow)::cursor cur{};
+    REQUIRE(flow.poll(cur) == flow::status::NOT_DONE);
+    REQUIRE(actual == "dbc");
+    REQUIRE(flow.poll(cur) == flow::status::NOT_DONE);
+    REQUIRE(flow.poll(cur) == flow::status::DONE);
+    REQUIRE(actual == "dbcdda");
+}
+
+TEST_CASE("constant async flow can be polled", "[async_flow]") {
+    constexpr auto builder = [] {
+        flow::async_builder<> fb;
+        fb.add(a >> disk >> b);
+        return fb;
+    }();
+    constexpr auto flow =
+        builder.topo_sort<flow::async_impl, builder.num_steps()>();
+
+    reset();
+    decltype(flow)::cursor cur{};
+    REQUIRE(flow.poll(cur) == flow::status::NOT_DONE);
+    REQUIRE(actual == "ad");
+    REQUIRE(flow.poll(cur) == flow::status::NOT_DONE);
+    REQUIRE(flow.poll(cur) == flow::status::DONE);
+    REQUIRE(actual == "adddb");
+
+    reset();
+    REQUIRE(flow.poll(cur) == flow::status::NOT_DONE);
+    REQUIRE(actual == "ad");
+}
+
+TEST_CASE("each cursor is a separate run of an async flow", "[async_flow]") {
+    flow::async_builder<> builder;
+    builder.add(a >> disk >> b);
+    auto const flow = builder.topo_sort<flow::async_impl, 3>();
+
+    reset();
+    decltype(flow)::cursor first{};
+    decltype(flow)::cursor second{};
+    REQUIRE(flow.poll(first) == flow::status::NOT_DONE);
+    REQUIRE(flow.poll(second) == flow::status::NOT_DONE);
+    REQUIRE(actual == "adad");
+    REQUIRE(flow.poll(first) == flow::status::DONE);
+    REQUIRE(actual == "adaddb");
+    REQUIRE(flow.poll(second) == flow::status::DONE);
+    REQUIRE(actual == "adaddbdb");
+}
+
+TEST_CASE("async action is polled once per run of other flows",
+          "[async_flow]") {
+    flow::builder<> builder;
+    builder.add(a >> disk >> b);
+    auto const flow = builder.topo_sort<flow::impl, 3>();
+
+    reset();
+    flow();
+    REQUIRE(actual == "adb");
+    REQUIRE(disk_polls == 1);
+}
+
+struct AsyncFlow : public flow::async_service<> {};
+
+struct AsyncFlowConfig {
+    constexpr static auto config =
+        cib::config(cib::exports<AsyncFlow>,
+                    cib::extend<AsyncFlow>(a >> (disk && net) >> b));
+};
+
+TEST_CASE("async flow through cib::nexus", "[async_flow]") {
+    cib::nexus<AsyncFlowConfig> nexus{};
+    nexus.init();
+
+    reset();
+    flow::run<AsyncFlow>();
+    REQUIRE(actual == "adn");
+    flow::run<AsyncFlow>();
+    flow::run<AsyncFlow>();
+    REQUIRE(actual.back() == 'b');
+    REQUIRE(disk_polls == 3);
+    REQUIRE(net_polls == 2);
+}
+} // namespace
@@ -24,6 +24,12 @@ TEST_CASE("build and run empty flow", "[flow]") {
     flow();
 }
 
+TEST_CASE("milestone trace hooks are left out when TRACE is compiled out",
+          "[flow]") {
+    static_assert(sizeof(flow::impl<decltype("named"_sc), 4>) ==
+                  sizeof(flow::impl<void, 4>));
+}
+
 TEST_CASE("add single action", "[flow]") {
     flow::builder<> builder;
     actual = "";
@@ -90,6 +96,24 @@ TEST_CASE("two milestone linear after dependency", "[flow]") {
     REQUIRE(actual == "ab");
 }
 
+TEST_CASE("milestones are left out of the built flow", "[flow]") {
+    constexpr auto builder = [] {
+        flow::builder<> fb;
+        fb.add(c >> milestone0 >> milestone1 >> a);
+        fb.add(milestone0 >> d);
+        return fb;
+    }();
+    static_assert(builder.size() == 5);
+    static_assert(builder.num_steps() == 3);
+
+    actual = "";
+    auto const flow = builder.topo_sort<flow::impl, builder.num_steps()>();
+    flow();
+
+    REQUIRE(actual.size() == 3);
+    REQUIRE(actual.front() == 'c');
+}
+
 TEST_CASE("three milestone linear before and after dependency", "[flow]") {
     flow::builder<> builder;
     actual = "";
@@ -332,4 +356,36 @@ TEST_CASE("add multi action through cib::nexus, run through cib::service",
 
     REQUIRE(actual == "abcd");
 }
+
+TEST_CASE("flow services are sized for their extensions", "[flow]") {
+    using builder_t = std::remove_cvref_t<decltype(cib::initialized<
+        MultiFlowMultiActionConfig, TestFlowAlpha>::value)>;
+    static_assert(std::is_same_v<builder_t, flow::builder<void, 3, 1>>);
+}
+
+template <std::size_t Id>
+constexpr auto chain_node = flow::action("chain_node"_sc, [] {});
+
+struct LongFlow : public flow::service<> {};
+
+template <std::size_t... Is>
+CIB_CONSTEVAL auto make_long_flow_config(std::index_sequence<Is...>) {
+    return cib::config(cib::exports<LongFlow>,
+                       cib::extend<LongFlow>((chain_node<Is> >>
+                                              chain_node<Is + 1>)...));
+}
+
+struct LongFlowConfig {
+    constexpr static auto config =
+        make_long_flow_config(std::make_index_sequence<80>{});
+};
+
+TEST_CASE("flow services grow past the default capacity", "[flow]") {
+    using builder_t = std::remove_cvref_t<
+        decltype(cib::initialized<LongFlowConfig, LongFlow>::value)>;
+    static_assert(std::is_same_v<builder_t, flow::builder<void, 160, 1>>);
+
+    cib::nexus<LongFlowConfig> nexus{};
+    nexus.service<LongFlow>();
+}
 } // namespace
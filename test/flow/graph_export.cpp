@@ -0,0 +1,73 @@
+#include <cib/cib.hpp>
+#include <flow/flow.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string_view>
+
+namespace {
+constexpr auto milestone0 = flow::milestone("milestone0"_sc);
+
+constexpr auto a = flow::action("a"_sc, [] {});
+constexpr auto b = flow::action("b"_sc, [] {});
+constexpr auto c = flow::action("c\"x"_sc, [] {});
+
+constexpr auto diamond = [] {
+    flow::builder<decltype("diamond"_sc)> builder;
+    builder.add(a >> (b && milestone0) >> c);
+    return builder;
+}();
+
+constexpr auto cycle = [] {
+    flow::builder<> builder;
+    builder.add(a >> b >> a);
+    return builder;
+}();
+
+TEST_CASE("export flow graph as DOT", "[graph_export]") {
+    static_assert(flow::dot_graph<diamond> ==
+                  "digraph \"diamond\" {\n"
+                  "    n0 [label=\"a\"];\n"
+                  "    n1 [label=\"b\"];\n"
+                  "    n2 [label=\"milestone0\", shape=diamond];\n"
+                  "    n3 [label=\"c\\\"x\"];\n"
+                  "    n0 -> n1;\n"
+                  "    n0 -> n2;\n"
+                  "    n1 -> n3;\n"
+                  "    n2 -> n3;\n"
+                  "}\n");
+}
+
+TEST_CASE("export flow graph as JSON", "[graph_export]") {
+    static_assert(flow::json_graph<diamond> ==
+                  "{\"name\": \"diamond\", \"nodes\": ["
+                  "{\"id\": 0, \"name\": \"a\", \"level\": 0}, "
+                  "{\"id\": 1, \"name\": \"b\", \"level\": 1}, "
+                  "{\"id\": 2, \"name\": \"milestone0\", \"level\": 1}, "
+                  "{\"id\": 3, \"name\": \"c\\\"x\", \"level\": 2}], "
+                  "\"edges\": [[0, 1], [0, 2], [1, 3], [2, 3]]}\n");
+}
+
+TEST_CASE("export circular flow graph without levels", "[graph_export]") {
+    static_assert(flow::json_graph<cycle> ==
+                  "{\"name\": null, \"nodes\": ["
+                  "{\"id\": 0, \"name\": \"a\"}, "
+                  "{\"id\": 1, \"name\": \"b\"}], "
+                  "\"edges\": [[0, 1], [1, 0]]}\n");
+}
+
+struct ExportedFlow : public flow::service<> {};
+
+struct ExportedFlowConfig {
+    constexpr static auto config = cib::config(
+        cib::exports<ExportedFlow>, cib::extend<ExportedFlow>(a >> b));
+};
+
+TEST_CASE("export the graph of a nexus service", "[graph_export]") {
+    constexpr auto dot =
+        flow::dot_graph<cib::initialized<ExportedFlowConfig,
+                                         ExportedFlow>::value>;
+    static_assert(dot.starts_with("digraph {\n"));
+    static_assert(dot.ends_with("    n0 -> n1;\n}\n"));
+}
+} // namespace
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cib/cib.hpp>
+#include <flow/flow.hpp>
+
+namespace graph_export_test {
+constexpr auto powered = flow::milestone("powered"_sc);
+constexpr auto load = flow::action("load"_sc, [] {});
+constexpr auto check = flow::action("check"_sc, [] {});
+constexpr auto start = flow::action("start"_sc, [] {});
+
+struct boot_flow : public flow::service<decltype("boot"_sc)> {};
+
+struct project {
+    constexpr static auto config =
+        cib::config(cib::exports<boot_flow>,
+                    cib::extend<boot_flow>(powered >> (load && check) >>
+                                           start));
+};
+} // namespace graph_export_test
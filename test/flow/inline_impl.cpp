@@ -0,0 +1,71 @@
+#include <cib/cib.hpp>
+#include <flow/flow.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+namespace {
+auto actual = std::string("");
+
+constexpr auto milestone0 = flow::milestone("milestone0"_sc);
+
+constexpr auto a = flow::action("a"_sc, [] { actual += "a"; });
+constexpr auto b = flow::action("b"_sc, [] { actual += "b"; });
+constexpr auto c = flow::action("c"_sc, [] { actual += "c"; });
+
+TEST_CASE("build and run empty inline flow", "[inline_flow]") {
+    flow::inline_builder<> builder;
+    auto const flow = builder.topo_sort<flow::inline_impl, 0>();
+    flow();
+    REQUIRE(flow.getBuildStatus() == flow::build_status::SUCCESS);
+}
+
+TEST_CASE("inline flow runs through its table at runtime", "[inline_flow]") {
+    flow::inline_builder<> builder;
+    actual = "";
+
+    builder.add(a >> milestone0 >> b);
+
+    auto const flow = builder.topo_sort<flow::inline_impl, 3>();
+    flow();
+
+    REQUIRE(actual == "ab");
+}
+
+constexpr auto constant_flow = [] {
+    flow::inline_builder<> builder;
+    builder.add(c >> b >> a);
+    return builder.topo_sort<flow::inline_impl, 3>();
+}();
+
+TEST_CASE("constant inline flow runs with direct calls", "[inline_flow]") {
+    actual = "";
+    decltype(constant_flow)::run<constant_flow>();
+    REQUIRE(actual == "cba");
+}
+
+struct InlineFlow : public flow::inline_service<> {};
+struct NamedInlineFlow
+    : public flow::inline_service<decltype("NamedInlineFlow"_sc)> {};
+
+struct InlineFlowConfig {
+    constexpr static auto config =
+        cib::config(cib::exports<InlineFlow, NamedInlineFlow>,
+                    cib::extend<InlineFlow>(a >> b >> c),
+                    cib::extend<NamedInlineFlow>(c >> milestone0 >> a));
+};
+
+TEST_CASE("inline flow through cib::nexus", "[inline_flow]") {
+    cib::nexus<InlineFlowConfig> nexus{};
+    nexus.init();
+
+    actual = "";
+    flow::run<InlineFlow>();
+    REQUIRE(actual == "abc");
+
+    actual = "";
+    flow::run<NamedInlineFlow>();
+    REQUIRE(actual == "ca");
+}
+} // namespace
@@ -0,0 +1,91 @@
+#include <flow/flow.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+constexpr auto milestone0 = flow::milestone("milestone0"_sc);
+
+constexpr auto a = flow::action("a"_sc, [] {});
+constexpr auto b = flow::action("b"_sc, [] {});
+constexpr auto c = flow::action("c"_sc, [] {});
+constexpr auto d = flow::action("d"_sc, [] {});
+
+TEST_CASE("levelize empty graph", "[levelized_graph]") {
+    constexpr auto levels = flow::builder<>{}.levelize();
+
+    static_assert(levels.size() == 0);
+    static_assert(levels.num_levels() == 0);
+    static_assert(levels.max_width() == 0);
+    static_assert(levels.critical_path_length() == 0);
+    static_assert(levels.getBuildStatus() == flow::build_status::SUCCESS);
+}
+
+TEST_CASE("levelize diamond", "[levelized_graph]") {
+    constexpr auto levels = [] {
+        flow::builder<> builder;
+        builder.add(a >> (b && c) >> d);
+        return builder.levelize();
+    }();
+
+    static_assert(levels.size() == 4);
+    static_assert(levels.depth_of(a) == 0);
+    static_assert(levels.depth_of(b) == 1);
+    static_assert(levels.depth_of(c) == 1);
+    static_assert(levels.depth_of(d) == 2);
+
+    static_assert(levels.num_levels() == 3);
+    static_assert(levels.width_of(0) == 1);
+    static_assert(levels.width_of(1) == 2);
+    static_assert(levels.width_of(2) == 1);
+    static_assert(levels.max_width() == 2);
+
+    static_assert(levels.critical_path_length() == 3);
+    static_assert(levels.critical_path()[0] == a);
+    static_assert(levels.critical_path()[2] == d);
+}
+
+TEST_CASE("critical path follows longest chain", "[levelized_graph]") {
+    constexpr auto levels = [] {
+        flow::builder<> builder;
+        builder.add(a >> b >> c >> milestone0);
+        builder.add(a >> d >> milestone0);
+        return builder.levelize();
+    }();
+
+    static_assert(levels.depth_of(d) == 1);
+    static_assert(levels.depth_of(milestone0) == 3);
+    static_assert(levels.critical_path_length() == 4);
+    static_assert(levels.critical_path()[0] == a);
+    static_assert(levels.critical_path()[1] == b);
+    static_assert(levels.critical_path()[2] == c);
+    static_assert(levels.critical_path()[3] == milestone0);
+}
+
+TEST_CASE("sorted depths never decrease", "[levelized_graph]") {
+    constexpr auto levels = [] {
+        flow::builder<> builder;
+        builder.add((a && b) >> c);
+        builder.add(d);
+        return builder.levelize();
+    }();
+
+    auto const &depths = levels.sorted_depths();
+    for (auto i = std::size_t{1}; i < depths.size(); ++i) {
+        REQUIRE(depths[i - 1] <= depths[i]);
+    }
+    REQUIRE(levels.width_of(0) == 3);
+}
+
+TEST_CASE("levelize reports circular dependency", "[levelized_graph]") {
+    constexpr auto levels = [] {
+        flow::builder<> builder;
+        builder.add(a >> b >> a);
+        builder.add(c);
+        return builder.levelize();
+    }();
+
+    static_assert(levels.getBuildStatus() ==
+                  flow::build_status::HAS_CIRCULAR_DEPENDENCY);
+    static_assert(levels.size() == 1);
+}
+} // namespace
@@ -0,0 +1,140 @@
+#include <cib/cib.hpp>
+#include <flow/flow.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+std::mutex actual_mutex;
+auto actual = std::string("");
+
+auto record(char c) -> void {
+    std::lock_guard lock{actual_mutex};
+    actual += c;
+}
+
+constexpr auto milestone0 = flow::milestone("milestone0"_sc);
+
+constexpr auto a = flow::action("a"_sc, [] { record('a'); });
+constexpr auto b = flow::action("b"_sc, [] { record('b'); });
+constexpr auto c = flow::action("c"_sc, [] { record('c'); });
+constexpr auto d = flow::action("d"_sc, [] { record('d'); });
+constexpr auto e = flow::action("e"_sc, [] { record('e'); });
+
+std::vector<std::size_t> batch_sizes{};
+
+struct recording_executor {
+    auto run(flow::FunctionPtr const *first,
+             flow::FunctionPtr const *last) const -> void {
+        batch_sizes.push_back(static_cast<std::size_t>(last - first));
+        flow::serial_executor{}.run(first, last);
+    }
+};
+
+struct thread_executor {
+    auto run(flow::FunctionPtr const *first,
+             flow::FunctionPtr const *last) const -> void {
+        std::vector<std::thread> threads{};
+        for (; first != last; ++first) {
+            threads.emplace_back(*first);
+        }
+        for (auto &t : threads) {
+            t.join();
+        }
+    }
+};
+
+TEST_CASE("build and run empty parallel flow", "[parallel_flow]") {
+    flow::parallel_builder<> builder;
+    auto const flow = builder.topo_sort<flow::parallel_impl, 0>();
+    flow();
+    REQUIRE(flow.getNumLevels() == 0);
+}
+
+TEST_CASE("independent actions share a level", "[parallel_flow]") {
+    flow::parallel_builder<> builder;
+    actual = "";
+    batch_sizes.clear();
+
+    builder.add(a >> (b && c) >> d);
+
+    auto const flow = builder.topo_sort<flow::parallel_impl, 4>();
+    flow(recording_executor{});
+
+    REQUIRE(flow.getBuildStatus() == flow::build_status::SUCCESS);
+    REQUIRE(flow.getNumLevels() == 3);
+    REQUIRE(batch_sizes == std::vector<std::size_t>{1, 2, 1});
+    REQUIRE(actual.front() == 'a');
+    REQUIRE(actual.back() == 'd');
+    REQUIRE(actual.size() == 4);
+}
+
+TEST_CASE("level of a node is its longest dependency chain",
+          "[parallel_flow]") {
+    flow::parallel_builder<> builder;
+    batch_sizes.clear();
+
+    builder.add(a >> b >> c >> e);
+    builder.add(a >> d >> e);
+
+    auto const flow = builder.topo_sort<flow::parallel_impl, 5>();
+    flow(recording_executor{});
+
+    REQUIRE(flow.getNumLevels() == 4);
+    REQUIRE(batch_sizes == std::vector<std::size_t>{1, 2, 1, 1});
+}
+
+TEST_CASE("milestones are dropped but still separate levels",
+          "[parallel_flow]") {
+    flow::parallel_builder<> builder;
+    batch_sizes.clear();
+
+    builder.add((a && b) >> milestone0 >> (c && d));
+
+    auto const flow = builder.topo_sort<flow::parallel_impl, 4>();
+    flow(recording_executor{});
+
+    REQUIRE(flow.getNumLevels() == 2);
+    REQUIRE(batch_sizes == std::vector<std::size_t>{2, 2});
+}
+
+TEST_CASE("levels run concurrently on a threaded executor",
+          "[parallel_flow]") {
+    flow::parallel_builder<void, thread_executor> builder;
+    actual = "";
+
+    builder.add((a && b) >> (c && d));
+
+    auto const flow = builder.topo_sort<
+        flow::parallel_builder<void, thread_executor>::impl_t, 4>();
+    flow();
+
+    REQUIRE(actual.size() == 4);
+    REQUIRE(actual.find('a') < actual.find('c'));
+    REQUIRE(actual.find('a') < actual.find('d'));
+    REQUIRE(actual.find('b') < actual.find('c'));
+    REQUIRE(actual.find('b') < actual.find('d'));
+}
+
+struct ParallelFlow : public flow::parallel_service<> {};
+
+struct ParallelFlowConfig {
+    constexpr static auto config = cib::config(
+        cib::exports<ParallelFlow>, cib::extend<ParallelFlow>(a >> (b && c)));
+};
+
+TEST_CASE("parallel flow through cib::nexus", "[parallel_flow]") {
+    cib::nexus<ParallelFlowConfig> nexus{};
+    nexus.init();
+    actual = "";
+
+    flow::run<ParallelFlow>();
+
+    REQUIRE(actual.size() == 3);
+    REQUIRE(actual.front() == 'a');
+}
+} // namespace
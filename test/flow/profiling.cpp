@@ -0,0 +1,82 @@
+#include <flow/flow.hpp>
+#include <log/fmt/logger.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <string>
+
+namespace {
+struct fake_clock {
+    using rep = std::int64_t;
+    using period = std::nano;
+    using duration = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<fake_clock>;
+    constexpr static bool is_steady = true;
+
+    static inline rep ticks{};
+    static auto now() -> time_point { return time_point{duration{ticks}}; }
+};
+
+std::string log_buffer{};
+} // namespace
+
+template <>
+inline auto logging::config<> =
+    logging::fmt::config{std::back_inserter(log_buffer)};
+
+template <>
+inline auto flow::profiling::config<> =
+    flow::profiling::enabled<fake_clock>{};
+
+namespace {
+std::int64_t b_cost{};
+
+constexpr auto a = flow::action("a"_sc, [] { fake_clock::ticks += 10; });
+constexpr auto b = flow::action("b"_sc, [] { fake_clock::ticks += b_cost; });
+
+using ProfiledFlowName = decltype("ProfiledFlow"_sc);
+
+TEST_CASE("unnamed flows are not profiled", "[flow_profiling]") {
+    static_assert(not flow::profiling::is_enabled<void>);
+    static_assert(flow::profiling::is_enabled<ProfiledFlowName>);
+}
+
+TEST_CASE("each step of a named flow is timed", "[flow_profiling]") {
+    flow::builder<ProfiledFlowName> builder;
+    builder.add(a >> b);
+    auto const flow = builder.topo_sort<flow::impl, 2>();
+
+    b_cost = 20;
+    flow();
+    b_cost = 40;
+    flow();
+
+    auto const &results = flow::profiling::results<ProfiledFlowName>;
+    REQUIRE(results.size() == 2);
+
+    REQUIRE(results.name(0) == "a");
+    REQUIRE(results[0].count == 2);
+    REQUIRE(results[0].last.count() == 10);
+    REQUIRE(results[0].average().count() == 10);
+
+    REQUIRE(results.name(1) == "b");
+    REQUIRE(results[1].count == 2);
+    REQUIRE(results[1].last.count() == 40);
+    REQUIRE(results[1].min.count() == 20);
+    REQUIRE(results[1].max.count() == 40);
+    REQUIRE(results[1].average().count() == 30);
+
+    log_buffer.clear();
+    flow::profiling::log_results<ProfiledFlowName>();
+    CAPTURE(log_buffer);
+    REQUIRE(log_buffer.find("flow.profile(ProfiledFlow): 2 steps\n") !=
+            std::string::npos);
+    REQUIRE(log_buffer.find("flow.profile step 0 (a): runs=2 last=10 "
+                            "min=10 max=10 avg=10\n") != std::string::npos);
+    REQUIRE(log_buffer.find("flow.profile step 1 (b): runs=2 last=40 "
+                            "min=20 max=40 avg=30\n") != std::string::npos);
+}
+} // namespace
@@ -0,0 +1,71 @@
+#include <flow/flow.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+constexpr auto milestone0 = flow::milestone("milestone0"_sc);
+
+constexpr auto a = flow::action("a"_sc, [] {});
+constexpr auto b = flow::action("b"_sc, [] {});
+constexpr auto c = flow::action("c"_sc, [] {});
+constexpr auto d = flow::action("d"_sc, [] {});
+constexpr auto e = flow::action("e"_sc, [] {});
+
+TEST_CASE("sortable graph has empty residual", "[residual_graph]") {
+    constexpr auto residual = [] {
+        flow::builder<> builder;
+        builder.add(a >> (b && c) >> d);
+        return builder.residual();
+    }();
+
+    static_assert(residual.empty());
+    static_assert(residual.remaining_edges().empty());
+    static_assert(residual.cycle().empty());
+}
+
+TEST_CASE("residual keeps only the cycle", "[residual_graph]") {
+    constexpr auto residual = [] {
+        flow::builder<> builder;
+        builder.add(a >> b >> c >> d);
+        builder.add(d >> b);
+        builder.add(d >> e);
+        return builder.residual();
+    }();
+
+    static_assert(residual.remaining_nodes().size() == 3);
+    static_assert(residual.remaining_nodes()[0] == b);
+    static_assert(residual.remaining_nodes()[1] == c);
+    static_assert(residual.remaining_nodes()[2] == d);
+    static_assert(residual.remaining_edges().size() == 3);
+
+    static_assert(residual.cycle().size() == 3);
+    static_assert(residual.cycle()[0] == b);
+    static_assert(residual.cycle()[1] == c);
+    static_assert(residual.cycle()[2] == d);
+}
+
+TEST_CASE("residual keeps paths between cycles", "[residual_graph]") {
+    constexpr auto residual = [] {
+        flow::builder<> builder;
+        builder.add(a >> b >> a);
+        builder.add(b >> milestone0 >> c >> d >> c);
+        return builder.residual();
+    }();
+
+    static_assert(residual.remaining_nodes().size() == 5);
+    static_assert(residual.cycle().size() == 2);
+    static_assert(residual.cycle()[0] == a);
+    static_assert(residual.cycle()[1] == b);
+}
+
+TEST_CASE("residual names the nodes of a cycle", "[residual_graph]") {
+    constexpr auto residual = [] {
+        flow::builder<> builder;
+        builder.add(milestone0 >> a >> milestone0);
+        return builder.residual();
+    }();
+
+    static_assert(residual.cycle()[0].get_name() == "milestone0");
+    static_assert(residual.cycle()[1].get_name() == "a");
+}
+} // namespace
@@ -0,0 +1,115 @@
+#include <cib/cib.hpp>
+#include <flow/flow.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <string>
+
+namespace {
+auto actual = std::string("");
+bool guard_open{};
+int guard_checks{};
+
+constexpr auto a = flow::action("a"_sc, [] { actual += "a"; });
+constexpr auto b = flow::action("b"_sc, [] { actual += "b"; });
+constexpr auto c = flow::action("c"_sc, [] { actual += "c"; });
+constexpr auto d = flow::action("d"_sc, [] { actual += "d"; });
+
+constexpr auto g = flow::action_if(
+    "g"_sc,
+    [] {
+        ++guard_checks;
+        return guard_open;
+    },
+    [] { actual += "g"; });
+
+TEST_CASE("flow runs a bounded number of steps per slice", "[sliced_flow]") {
+    flow::builder<> builder;
+    builder.add(a >> b >> c >> d);
+    auto const flow = builder.topo_sort<flow::impl, 4>();
+    decltype(flow)::cursor cursor{};
+
+    actual = "";
+    REQUIRE(flow.run_slice(cursor, 3) == flow::status::NOT_DONE);
+    REQUIRE(actual == "abc");
+    REQUIRE(flow.run_slice(cursor, 3) == flow::status::DONE);
+    REQUIRE(actual == "abcd");
+
+    REQUIRE(flow.run_slice(cursor, 1) == flow::status::NOT_DONE);
+    REQUIRE(actual == "abcda");
+}
+
+TEST_CASE("guard is checked once when its segment starts", "[sliced_flow]") {
+    flow::builder<> builder;
+    builder.add(a >> g >> b);
+    auto const flow = builder.topo_sort<flow::impl, 3>();
+    decltype(flow)::cursor cursor{};
+
+    actual = "";
+    guard_open = true;
+    guard_checks = 0;
+    while (flow.run_slice(cursor, 1) == flow::status::NOT_DONE) {
+    }
+    REQUIRE(actual == "agb");
+    REQUIRE(guard_checks == 1);
+
+    actual = "";
+    guard_open = false;
+    while (flow.run_slice(cursor, 1) == flow::status::NOT_DONE) {
+    }
+    REQUIRE(actual == "ab");
+    REQUIRE(guard_checks == 2);
+}
+
+struct step_clock {
+    using rep = long;
+    using period = std::micro;
+    using duration = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<step_clock>;
+    constexpr static bool is_steady = true;
+
+    static inline rep ticks{};
+
+    static auto now() -> time_point { return time_point{duration{ticks++}}; }
+};
+
+TEST_CASE("flow runs steps until the time budget elapses", "[sliced_flow]") {
+    flow::builder<> builder;
+    builder.add(a >> b >> c >> d);
+    auto const flow = builder.topo_sort<flow::impl, 4>();
+    decltype(flow)::cursor cursor{};
+
+    actual = "";
+    step_clock::ticks = 0;
+    auto const budget = std::chrono::microseconds{3};
+    REQUIRE(flow.run_slice<step_clock>(cursor, budget) ==
+            flow::status::NOT_DONE);
+    REQUIRE(actual == "abc");
+
+    auto const none = std::chrono::microseconds{0};
+    REQUIRE(flow.run_slice<step_clock>(cursor, none) == flow::status::DONE);
+    REQUIRE(actual == "abcd");
+}
+
+struct SlicedFlow : public flow::sliced_service<void, 2> {};
+
+struct SlicedFlowConfig {
+    constexpr static auto config =
+        cib::config(cib::exports<SlicedFlow>,
+                    cib::extend<SlicedFlow>(a >> b >> c >> d));
+};
+
+TEST_CASE("sliced flow through cib::nexus", "[sliced_flow]") {
+    cib::nexus<SlicedFlowConfig> nexus{};
+    nexus.init();
+
+    actual = "";
+    flow::run<SlicedFlow>();
+    REQUIRE(actual == "ab");
+    flow::run<SlicedFlow>();
+    REQUIRE(actual == "abcd");
+    flow::run<SlicedFlow>();
+    REQUIRE(actual == "abcdab");
+}
+} // namespace
@@ -0,0 +1,58 @@
+#include <cib/cib.hpp>
+#include <flow/flow.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+namespace {
+auto actual = std::string("");
+
+constexpr auto milestone0 = flow::milestone("milestone0"_sc);
+
+constexpr auto a = flow::action("a"_sc, [] { actual += "a"; });
+constexpr auto b = flow::action("b"_sc, [] { actual += "b"; });
+constexpr auto c = flow::action("c"_sc, [] { actual += "c"; });
+constexpr auto d = flow::action("d"_sc, [] { actual += "d"; });
+
+constexpr auto storage =
+    flow::sub_flow("storage"_sc, [] { return c >> milestone0 >> b; });
+
+TEST_CASE("sub-flow runs its steps in order", "[sub_flow]") {
+    actual = "";
+    storage();
+    REQUIRE(actual == "cb");
+}
+
+TEST_CASE("sub-flow is a single node of the outer flow", "[sub_flow]") {
+    constexpr auto builder = [] {
+        flow::builder<> outer;
+        outer.add(a >> storage >> d);
+        return outer;
+    }();
+    static_assert(builder.size() == 3);
+
+    actual = "";
+    auto const flow = builder.topo_sort<flow::impl, builder.num_steps()>();
+    flow();
+    REQUIRE(actual == "acbd");
+}
+
+struct ComposedFlow : public flow::service<> {};
+
+struct ComposedFlowConfig {
+    constexpr static auto config =
+        cib::config(cib::exports<ComposedFlow>,
+                    cib::extend<ComposedFlow>(a >> storage),
+                    cib::extend<ComposedFlow>(storage >> d));
+};
+
+TEST_CASE("sub-flow through cib::nexus", "[sub_flow]") {
+    cib::nexus<ComposedFlowConfig> nexus{};
+    nexus.init();
+
+    actual = "";
+    flow::run<ComposedFlow>();
+    REQUIRE(actual == "acbd");
+}
+} // namespace
@@ -0,0 +1,91 @@
+#include <flow/flow.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace {
+struct fake_clock {
+    using rep = std::int64_t;
+    using period = std::micro;
+    using duration = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<fake_clock>;
+    constexpr static bool is_steady = true;
+
+    static inline rep ticks{};
+    static auto now() -> time_point { return time_point{duration{ticks++}}; }
+};
+} // namespace
+
+template <>
+inline auto flow::trace::config<> = flow::trace::sink<fake_clock, 16>{};
+
+namespace {
+constexpr auto a = flow::action("a"_sc, [] {});
+constexpr auto b = flow::action("b"_sc, [] {});
+
+using TracedFlowName = decltype("TracedFlow"_sc);
+
+TEST_CASE("ring buffer keeps the newest records", "[flow_trace]") {
+    flow::trace::ring_buffer<4> buffer{};
+    for (auto i = std::uint32_t{}; i < 6; ++i) {
+        buffer.write({i, i, 0, flow::trace::event::STEP});
+    }
+
+    REQUIRE(buffer.size() == 4);
+    REQUIRE(buffer.dropped() == 2);
+    REQUIRE(buffer[0].id == 2);
+    REQUIRE(buffer[3].id == 5);
+}
+
+TEST_CASE("ring buffer keeps counting past 2^32 records", "[flow_trace]") {
+    flow::trace::ring_buffer<4> buffer{std::uint64_t{0xffff'fffe}};
+    for (auto i = std::uint32_t{}; i < 6; ++i) {
+        buffer.write({i, i, 0, flow::trace::event::STEP});
+    }
+
+    REQUIRE(buffer.size() == 4);
+    REQUIRE(buffer.dropped() == 0x1'0000'0000);
+    REQUIRE(buffer[0].id == 2);
+    REQUIRE(buffer[3].id == 5);
+}
+
+TEST_CASE("named flow writes begin, step and end records",
+          "[flow_trace][flow_trace_dump]") {
+    flow::builder<TracedFlowName> builder;
+    builder.add(a >> b);
+    auto const flow = builder.topo_sort<flow::impl, 2>();
+    flow();
+
+    auto const &records = flow::trace::config<>.records();
+    REQUIRE(records.size() == 4);
+
+    REQUIRE(records[0].kind == flow::trace::event::FLOW_BEGIN);
+    REQUIRE(records[0].id == flow::trace::id_of<TracedFlowName>);
+    REQUIRE(records[1].kind == flow::trace::event::STEP);
+    REQUIRE(records[1].id == flow::trace::hash("a"));
+    REQUIRE(records[2].id == flow::trace::hash("b"));
+    REQUIRE(records[3].kind == flow::trace::event::FLOW_END);
+    REQUIRE(records[0].timestamp < records[3].timestamp);
+
+    std::vector<std::uint8_t> bytes{};
+    flow::trace::config<>.dump(std::back_inserter(bytes));
+
+    REQUIRE(bytes.size() > 4);
+    REQUIRE(bytes[0] == 'C');
+    REQUIRE(bytes[3] == 'T');
+
+    auto const names_offset = std::size_t{4 + 4 + 8 + 8};
+    REQUIRE(bytes[names_offset] == 3);
+
+    // converted by the flow_trace_to_chrome test
+    std::ofstream out{"flow_trace.cibt", std::ios::binary};
+    out.write(reinterpret_cast<char const *>(bytes.data()),
+              static_cast<std::streamsize>(bytes.size()));
+    REQUIRE(out.good());
+}
+} // namespace
@@ -91,6 +91,11 @@ TEST_CASE("log levels are properly represented", "[log]") {
     }
 }
 
+TEST_CASE("config without max_level keeps every level", "[log]") {
+    static_assert(logging::is_enabled<logging::level::TRACE>);
+    static_assert(logging::is_enabled<logging::level::FATAL>);
+}
+
 TEST_CASE("logging can use std::cout", "[log]") {
     [[maybe_unused]] auto cfg =
         logging::fmt::config{std::ostream_iterator<char>{std::cout}};
@@ -2,6 +2,8 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <type_traits>
+
 static bool terminated{};
 struct test_config : logging::null::config {
     static auto terminate() noexcept -> void { terminated = true; }
@@ -13,3 +15,10 @@ TEST_CASE("FATAL calls terminate", "[log]") {
     CIB_FATAL("Hello");
     REQUIRE(terminated);
 }
+
+TEST_CASE("config derived from the null config keeps every level", "[log]") {
+    static_assert(logging::is_enabled<logging::level::TRACE>);
+    static_assert(logging::is_enabled<logging::level::FATAL>);
+    static_assert(std::is_same_v<decltype(logging::config<>.logger),
+                                 logging::null::logger>);
+}
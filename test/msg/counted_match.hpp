@@ -0,0 +1,29 @@
+#pragma once
+
+#include <sc/string_constant.hpp>
+
+#include <cstdint>
+
+namespace msg {
+/**
+ * A field requirement that holds when Field equals Value, and counts how many
+ * times it is checked, so that tests and benchmarks can see how often a
+ * message is validated.
+ */
+template <typename Field, auto Value> struct counted_match {
+    static inline std::uint64_t checks{};
+
+    template <typename MsgType>
+    [[nodiscard]] constexpr auto operator()(MsgType const &msg) const -> bool {
+        ++checks;
+        return msg.template get<Field>() == Value;
+    }
+
+    [[nodiscard]] constexpr auto describe() const { return "counted"_sc; }
+
+    template <typename MsgType>
+    [[nodiscard]] constexpr auto describe_match(MsgType const &) const {
+        return "counted"_sc;
+    }
+};
+} // namespace msg
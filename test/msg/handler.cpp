@@ -1,7 +1,14 @@
+#include "counted_match.hpp"
+
 #include <msg/handler.hpp>
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
 namespace msg {
 
 bool correctDispatch = false;
@@ -143,4 +150,198 @@ TEST_CASE("TestMsgMultipleLambdaCallback", "[handler]") {
     }
 }
 
+int matcher_evaluations{};
+
+auto const counting_matcher = matcher<TestBaseMsg>(
+    "counted"_sc, [](TestBaseMsg const &) {
+        ++matcher_evaluations;
+        return true;
+    });
+
+template <std::uint32_t Id>
+using TestIdMsg = message_base<decltype("TestIdMsg"_sc), 2,
+                               TestIdField::WithRequired<Id>, TestField1>;
+
+using TestAnyIdMsg = message_base<decltype("TestAnyIdMsg"_sc), 2, TestField1>;
+
+TEST_CASE("only callbacks accepting the key are tried", "[handler]") {
+    std::uint32_t handled_id{};
+    auto const make_callback = [&]<std::uint32_t Id>(
+                                   std::integral_constant<std::uint32_t, Id>) {
+        return msg::callback<TestBaseMsg>(
+            "TestCallback"_sc, counting_matcher,
+            [&](TestIdMsg<Id> const &) { handled_id = Id; });
+    };
+
+    auto callbacks = cib::make_tuple(
+        make_callback(std::integral_constant<std::uint32_t, 0x10>{}),
+        make_callback(std::integral_constant<std::uint32_t, 0x20>{}),
+        make_callback(std::integral_constant<std::uint32_t, 0x30>{}),
+        make_callback(std::integral_constant<std::uint32_t, 0x40>{}));
+    auto const handler =
+        msg::handler<decltype(callbacks), TestBaseMsg>{callbacks};
+
+    matcher_evaluations = 0;
+    handler.handle(TestBaseMsg{0x3000ba11, 0x0042d00d});
+    REQUIRE(handled_id == 0x30);
+    REQUIRE(matcher_evaluations == 1);
+
+    matcher_evaluations = 0;
+    handler.handle(TestBaseMsg{0x1000ba11, 0x0042d00d});
+    REQUIRE(handled_id == 0x10);
+    REQUIRE(matcher_evaluations == 1);
+}
+
+TEST_CASE("indexed dispatch keeps registration order", "[handler]") {
+    auto first = 0;
+    auto const keyed = msg::callback<TestBaseMsg>(
+        "Keyed"_sc, match::always<true>,
+        [&](TestIdMsg<0x10> const &) { first = 1; });
+    auto const unkeyed = msg::callback<TestBaseMsg>(
+        "Unkeyed"_sc, match::always<true>,
+        [&](TestAnyIdMsg const &) { first = 2; });
+
+    {
+        auto callbacks = cib::make_tuple(keyed, unkeyed);
+        auto const handler =
+            msg::handler<decltype(callbacks), TestBaseMsg>{callbacks};
+
+        handler.handle(TestBaseMsg{0x1000ba11, 0x0042d00d});
+        REQUIRE(first == 1);
+        handler.handle(TestBaseMsg{0x2000ba11, 0x0042d00d});
+        REQUIRE(first == 2);
+    }
+    {
+        auto callbacks = cib::make_tuple(unkeyed, keyed);
+        auto const handler =
+            msg::handler<decltype(callbacks), TestBaseMsg>{callbacks};
+
+        first = 0;
+        handler.handle(TestBaseMsg{0x1000ba11, 0x0042d00d});
+        REQUIRE(first == 2);
+    }
+}
+
+TEST_CASE("messages too short for the key try every callback", "[handler]") {
+    auto handled = false;
+    auto const keyed = msg::callback<TestBaseMsg>(
+        "Keyed"_sc, match::always<true>,
+        [&](TestIdMsg<0x10> const &) { REQUIRE(false); });
+    auto const unkeyed = msg::callback<TestBaseMsg>(
+        "Unkeyed"_sc, match::always<true>,
+        [&](TestAnyIdMsg const &) { handled = true; });
+
+    auto callbacks = cib::make_tuple(keyed, unkeyed);
+    auto const handler =
+        msg::handler<decltype(callbacks), TestBaseMsg>{callbacks};
+
+    handler.handle(TestBaseMsg{});
+    REQUIRE(handled);
+}
+
+using counted_id = counted_match<TestIdField, 0x50u>;
+
+using TestCountedMsg =
+    message_base<decltype("TestCountedMsg"_sc), 2,
+                 TestIdField::WithMatch<counted_id>, TestField1>;
+
+TEST_CASE("callables share one decoded message", "[handler]") {
+    auto calls = 0;
+    auto const callback = msg::callback<TestBaseMsg>(
+        "TestCallback"_sc, match::always<true>,
+        [&](TestCountedMsg const &) { ++calls; },
+        [&](TestCountedMsg const &msg) {
+            ++calls;
+            REQUIRE(msg.get<TestField1>() == 0xba11);
+        },
+        [&](TestMsg const &) { REQUIRE(false); });
+
+    auto callbacks = cib::make_tuple(callback);
+    auto const handler =
+        msg::handler<decltype(callbacks), TestBaseMsg>{callbacks};
+
+    counted_id::checks = 0;
+    handler.handle(TestBaseMsg{0x5000ba11, 0x0042d00d});
+    REQUIRE(calls == 2);
+    REQUIRE(counted_id::checks == 1);
+}
+
+TEST_CASE("handle_batch keeps arrival order", "[handler]") {
+    std::vector<std::uint32_t> order{};
+    auto const record = [&](auto const &msg) {
+        order.push_back(msg.template get<TestField1>());
+    };
+    auto const callback_10 = msg::callback<TestBaseMsg>(
+        "Callback10"_sc, match::always<true>,
+        [&](TestIdMsg<0x10> const &msg) { record(msg); });
+    auto const callback_20 = msg::callback<TestBaseMsg>(
+        "Callback20"_sc, match::always<true>,
+        [&](TestIdMsg<0x20> const &msg) { record(msg); });
+
+    auto callbacks = cib::make_tuple(callback_10, callback_20);
+    auto const handler =
+        msg::handler<decltype(callbacks), TestBaseMsg>{callbacks};
+    msg::handler_interface<TestBaseMsg> const &service = handler;
+
+    auto const msgs = std::array{
+        TestBaseMsg{0x10000001, 0}, TestBaseMsg{0x20000002, 0},
+        TestBaseMsg{0x10000003, 0}, TestBaseMsg{0x20000004, 0}};
+    service.handle_batch(msgs);
+    REQUIRE(order == std::vector<std::uint32_t>{1, 2, 3, 4});
+}
+
+TEST_CASE("handle_batch defaults to handling messages one by one",
+          "[handler]") {
+    struct counting_handler : msg::handler_interface<TestBaseMsg> {
+        mutable int handled{};
+
+        auto is_match(TestBaseMsg const &) const -> bool override {
+            return true;
+        }
+        void handle(TestBaseMsg const &) const override { ++handled; }
+    };
+
+    auto const handler = counting_handler{};
+    auto const msgs = std::array{TestBaseMsg{0x10000001, 0},
+                                 TestBaseMsg{0x20000002, 0}};
+    handler.handle_batch(msgs);
+    REQUIRE(handler.handled == 2);
+}
+
+TEST_CASE("handle_batch handles every message", "[handler]") {
+    auto handled = std::uint32_t{};
+    auto const callback = msg::callback<TestBaseMsg>(
+        "Callback"_sc, match::always<true>,
+        [&](TestIdMsg<0x10> const &msg) { handled += msg.get<TestField1>(); });
+
+    auto callbacks = cib::make_tuple(callback);
+    auto const handler =
+        msg::handler<decltype(callbacks), TestBaseMsg>{callbacks};
+
+    std::vector<TestBaseMsg> msgs(100, TestBaseMsg{0x10000001, 0});
+    handler.handle_batch(msgs);
+    REQUIRE(handled == 100);
+}
+
+TEST_CASE("callbacks can take views of the received data", "[handler]") {
+    using raw_msg = std::span<std::uint32_t const>;
+    std::array<std::uint32_t, 2> const buffer{0x8000ba11, 0x0042d00d};
+
+    std::uint32_t const *seen{};
+    auto const callback = msg::callback<raw_msg>(
+        "TestCallback"_sc, match::always<true>,
+        [&](message_view<TestMsg> const &msg) {
+            seen = msg.data().data();
+            REQUIRE(msg.get<TestField1>() == 0xba11);
+        },
+        [&](message_view<TestMsgFieldRequired> const &) { REQUIRE(false); });
+
+    auto callbacks = cib::make_tuple(callback);
+    auto const handler = msg::handler<decltype(callbacks), raw_msg>{callbacks};
+
+    REQUIRE(handler.is_match(raw_msg{buffer}));
+    handler.handle(raw_msg{buffer});
+    REQUIRE(seen == buffer.data());
+}
+
 } // namespace msg
@@ -3,6 +3,9 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
+#include <type_traits>
+
 namespace msg {
 
 using test_id_field =
@@ -42,4 +45,33 @@ TEST_CASE("build handler", "[handler_builder]") {
     REQUIRE(callback_success);
 }
 
+TEST_CASE("handle a batch through the service", "[handler_builder]") {
+    cib::nexus<test_project> test_nexus{};
+    test_nexus.init();
+
+    callback_success = false;
+
+    auto const msgs = std::array{test_msg_t{test_id_field{0x80}},
+                                 test_msg_t{test_id_field{0x80}}};
+    cib::service<test_service>->handle_batch(msgs);
+
+    REQUIRE(callback_success);
+}
+
+TEST_CASE("dispatch to the concrete handler", "[handler_builder]") {
+    cib::nexus<test_project> test_nexus{};
+
+    using handler_t = std::remove_cvref_t<decltype(handler_of<test_service>(
+        test_nexus))>;
+    static_assert(not std::is_pointer_v<handler_t>);
+    static_assert(
+        std::is_base_of_v<handler_interface<test_msg_t>, handler_t>);
+
+    callback_success = false;
+
+    msg::dispatch<test_service>(test_nexus, test_msg_t{test_id_field{0x80}});
+
+    REQUIRE(callback_success);
+}
+
 } // namespace msg
@@ -3,6 +3,9 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
+#include <cstdint>
+
 namespace msg {
 using TestIdField = field<decltype("TestIdField"_sc), 0, 31, 24, std::uint32_t>;
 
@@ -227,4 +230,42 @@ TEST_CASE("LessThanOrEqualToMatcher", "[message]") {
     CHECK_FALSE(TestField3::less_than_or_equal_to<0x1111>(msg));
 }
 
+TEST_CASE("message_view reads fields in place", "[message]") {
+    std::array<std::uint32_t, 2> const buffer{0x8000ba11, 0x0042d00d};
+    message_view<TestMsg> const view{buffer};
+
+    CHECK(view.data().data() == buffer.data());
+    CHECK(view.isValid());
+    CHECK(0x80 == view.get<TestIdField>());
+    CHECK(0xba11 == view.get<TestField1>());
+    CHECK(0x42 == view.get<TestField2>());
+    CHECK(0xd00d == view.get<TestField3>());
+}
+
+TEST_CASE("message_view of an owning message", "[message]") {
+    TestMsg const msg{TestField1{0xba11}, TestField2{0x42}};
+    message_view<TestMsg> const view{msg};
+
+    CHECK(view.data().data() == &msg[0]);
+    CHECK(0xba11 == view.get<TestField1>());
+    CHECK(0x42 == view.get<TestField2>());
+}
+
+TEST_CASE("message_view is validated like its message type", "[message]") {
+    std::array<std::uint32_t, 2> const buffer{0x4400ba11, 0x0042d00d};
+    CHECK(not message_view<TestMsg>{buffer}.isValid());
+    CHECK(not TestMsg{buffer}.isValid());
+}
+
+TEST_CASE("message_view describes its fields", "[message]") {
+    std::array<std::uint32_t, 2> const buffer{0x8000ba11, 0x0042d00d};
+    message_view<TestMsg> const view{buffer};
+
+    CHECK(view.describe() ==
+          sc::lazy_string_format{
+              "TestMsg(TestIdField: 0x{:x}, TestField1: 0x{:x}, "
+              "TestField2: 0x{:x}, TestField4: 0x{:x})"_sc,
+              cib::make_tuple(0x80u, 0xba11u, 0x42u, 0xd00du)});
+}
+
 } // namespace msg
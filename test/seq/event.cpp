@@ -0,0 +1,204 @@
+#include <seq/builder.hpp>
+#include <seq/event.hpp>
+#include <seq/impl.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <string>
+
+struct event_test_config : logging::null::config {
+    struct exception {};
+
+    static auto terminate() -> void { throw exception{}; }
+};
+
+template <> inline auto logging::config<> = event_test_config{};
+
+namespace {
+constexpr auto rail_good = seq::event{3};
+constexpr auto timer = seq::event{4};
+
+std::string result;
+bool rail_up{};
+
+auto const enable = seq::step(
+    "enable"_sc,
+    []() -> seq::status {
+        result += "Fe";
+        return seq::status::DONE;
+    },
+    []() -> seq::status {
+        result += "Be";
+        return seq::status::DONE;
+    });
+
+auto const ramp = seq::step(
+    "ramp"_sc,
+    []() -> seq::step_result {
+        result += "Fr";
+        return rail_up ? seq::status::DONE : seq::wait_for(rail_good);
+    },
+    []() -> seq::status {
+        result += "Br";
+        return seq::status::DONE;
+    });
+
+auto const spin = seq::step(
+    "spin"_sc,
+    []() -> seq::status {
+        result += "Fs";
+        return rail_up ? seq::status::DONE : seq::status::NOT_DONE;
+    },
+    []() -> seq::status {
+        result += "Bs";
+        return seq::status::DONE;
+    });
+
+auto const settle = seq::step(
+    "settle"_sc,
+    []() -> seq::step_result {
+        result += "Ft";
+        return rail_up ? seq::status::DONE : seq::wait_for(rail_good, timer);
+    },
+    []() -> seq::status {
+        result += "Bt";
+        return seq::status::DONE;
+    });
+
+auto reset() -> void {
+    result = "";
+    rail_up = false;
+}
+
+TEST_CASE("waiting step is not polled until its event fires", "[seq_event]") {
+    reset();
+    seq::builder<> builder;
+    builder.add(enable >> ramp);
+    auto seq_impl = builder.topo_sort<seq::impl, 2>();
+
+    REQUIRE(seq_impl.forward() == seq::status::NOT_DONE);
+    REQUIRE(result == "FeFr");
+    REQUIRE(seq_impl.is_waiting());
+
+    REQUIRE(seq_impl.forward() == seq::status::NOT_DONE);
+    REQUIRE(seq_impl.forward() == seq::status::NOT_DONE);
+    REQUIRE(result == "FeFr");
+
+    seq_impl.notify(timer);
+    REQUIRE(seq_impl.is_waiting());
+    REQUIRE(seq_impl.forward() == seq::status::NOT_DONE);
+    REQUIRE(result == "FeFr");
+
+    rail_up = true;
+    seq_impl.notify(rail_good);
+    REQUIRE(not seq_impl.is_waiting());
+    REQUIRE(seq_impl.forward() == seq::status::DONE);
+    REQUIRE(result == "FeFrFr");
+}
+
+TEST_CASE("spurious wake up polls the step again", "[seq_event]") {
+    reset();
+    seq::builder<> builder;
+    builder.add(ramp);
+    auto seq_impl = builder.topo_sort<seq::impl, 1>();
+
+    REQUIRE(seq_impl.forward() == seq::status::NOT_DONE);
+    seq_impl.notify(rail_good);
+    REQUIRE(seq_impl.forward() == seq::status::NOT_DONE);
+    REQUIRE(result == "FrFr");
+    REQUIRE(seq_impl.is_waiting());
+}
+
+TEST_CASE("event fired while the step runs is not lost", "[seq_event]") {
+    reset();
+    seq::builder<> builder;
+    builder.add(ramp);
+    auto seq_impl = builder.topo_sort<seq::impl, 1>();
+
+    seq_impl.notify(rail_good);
+    REQUIRE(seq_impl.forward() == seq::status::NOT_DONE);
+    REQUIRE(not seq_impl.is_waiting());
+    REQUIRE(seq_impl.forward() == seq::status::NOT_DONE);
+    REQUIRE(result == "FrFr");
+}
+
+TEST_CASE("steps without a wait condition are polled every time",
+          "[seq_event]") {
+    reset();
+    seq::builder<> builder;
+    builder.add(spin);
+    auto seq_impl = builder.topo_sort<seq::impl, 1>();
+
+    REQUIRE(seq_impl.forward() == seq::status::NOT_DONE);
+    REQUIRE(not seq_impl.is_waiting());
+    REQUIRE(seq_impl.forward() == seq::status::NOT_DONE);
+    REQUIRE(result == "FsFs");
+}
+
+TEST_CASE("backward waits for the forward step's event first",
+          "[seq_event]") {
+    reset();
+    seq::builder<> builder;
+    builder.add(enable >> ramp);
+    auto seq_impl = builder.topo_sort<seq::impl, 2>();
+
+    REQUIRE(seq_impl.forward() == seq::status::NOT_DONE);
+    REQUIRE(seq_impl.backward() == seq::status::NOT_DONE);
+    REQUIRE(result == "FeFr");
+
+    rail_up = true;
+    seq_impl.notify(rail_good);
+    REQUIRE(seq_impl.backward() == seq::status::DONE);
+    REQUIRE(result == "FeFrFrBrBe");
+}
+TEST_CASE("a step can wait for any of several events", "[seq_event]") {
+    reset();
+    seq::builder<> builder;
+    builder.add(settle);
+    auto seq_impl = builder.topo_sort<seq::impl, 1>();
+
+    REQUIRE(seq_impl.forward() == seq::status::NOT_DONE);
+    REQUIRE(seq_impl.is_waiting());
+    seq_impl.notify(timer);
+    REQUIRE(not seq_impl.is_waiting());
+    REQUIRE(seq_impl.forward() == seq::status::NOT_DONE);
+    REQUIRE(result == "FtFt");
+
+    seq_impl.notify(rail_good);
+    REQUIRE(seq_impl.forward() == seq::status::NOT_DONE);
+    REQUIRE(result == "FtFtFt");
+}
+
+TEST_CASE("sequences keep their own waits", "[seq_event]") {
+    reset();
+    seq::builder<> waiting;
+    waiting.add(ramp);
+    auto waiting_impl = waiting.topo_sort<seq::impl, 1>();
+    seq::builder<> polling;
+    polling.add(spin);
+    auto polling_impl = polling.topo_sort<seq::impl, 1>();
+
+    REQUIRE(waiting_impl.forward() == seq::status::NOT_DONE);
+    REQUIRE(polling_impl.forward() == seq::status::NOT_DONE);
+    REQUIRE(waiting_impl.is_waiting());
+    REQUIRE(not polling_impl.is_waiting());
+    REQUIRE(polling_impl.forward() == seq::status::NOT_DONE);
+    REQUIRE(result == "FrFsFs");
+}
+
+TEST_CASE("wait_for combines its events", "[seq_event]") {
+    static_assert(seq::wait_for(rail_good) ==
+                  seq::step_result{seq::status::NOT_DONE, 1u << 3});
+    static_assert(
+        seq::wait_for(rail_good, timer) ==
+        seq::step_result{seq::status::NOT_DONE, (1u << 3) | (1u << 4)});
+}
+
+TEST_CASE("event ids are limited to 32", "[seq_event]") {
+    REQUIRE(seq::event{31}.mask() == 0x8000'0000u);
+
+    auto id = std::uint8_t{32};
+    REQUIRE_THROWS_AS(seq::event{id}, event_test_config::exception);
+}
+} // namespace
@@ -0,0 +1,105 @@
+#include <seq/builder.hpp>
+#include <seq/impl.hpp>
+#include <seq/instrumentation.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdint>
+
+namespace {
+struct fake_clock {
+    using rep = std::int64_t;
+    using period = std::micro;
+    using duration = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<fake_clock>;
+    constexpr static bool is_steady = true;
+
+    static inline rep ticks{};
+    static auto now() -> time_point { return time_point{duration{ticks}}; }
+};
+} // namespace
+
+template <>
+inline auto seq::instrumentation::config<> =
+    seq::instrumentation::enabled<fake_clock, 8>{};
+
+namespace {
+int ramp_polls{};
+int ramp_target{};
+
+auto const enable = seq::step(
+    "enable"_sc, []() -> seq::status { return seq::status::DONE; },
+    []() -> seq::status { return seq::status::DONE; });
+
+auto const ramp = seq::step(
+    "ramp"_sc,
+    []() -> seq::status {
+        fake_clock::ticks += 5;
+        return ++ramp_polls < ramp_target ? seq::status::NOT_DONE
+                                          : seq::status::DONE;
+    },
+    []() -> seq::status {
+        fake_clock::ticks += 100;
+        return seq::status::DONE;
+    });
+
+using PowerUpName = decltype("PowerUp"_sc);
+
+TEST_CASE("log histogram buckets", "[seq_instrumentation]") {
+    using histogram = seq::instrumentation::log_histogram<4>;
+    static_assert(histogram::bucket_of(0) == 0);
+    static_assert(histogram::bucket_of(1) == 1);
+    static_assert(histogram::bucket_of(2) == 2);
+    static_assert(histogram::bucket_of(3) == 2);
+    static_assert(histogram::bucket_of(4) == 3);
+    static_assert(histogram::bucket_of(1000) == 3);
+    static_assert(histogram::lower_bound(3) == 4);
+}
+
+TEST_CASE("unnamed sequences are not instrumented", "[seq_instrumentation]") {
+    static_assert(not seq::instrumentation::is_enabled<void>);
+    static_assert(seq::instrumentation::is_enabled<PowerUpName>);
+    static_assert(sizeof(seq::impl<void, 2>) <
+                  sizeof(seq::impl<PowerUpName, 2>));
+}
+
+TEST_CASE("polls and time until done are recorded per step and direction",
+          "[seq_instrumentation]") {
+    seq::builder<PowerUpName> builder;
+    builder.add(enable >> ramp);
+    auto seq_impl = builder.topo_sort<seq::impl, 2>();
+
+    ramp_polls = 0;
+    ramp_target = 3;
+    while (seq_impl.forward() == seq::status::NOT_DONE) {
+    }
+    REQUIRE(seq_impl.backward() == seq::status::DONE);
+
+    ramp_polls = 0;
+    ramp_target = 6;
+    while (seq_impl.forward() == seq::status::NOT_DONE) {
+    }
+
+    auto const &results = seq::instrumentation::results<PowerUpName>;
+    REQUIRE(results.size() == 2);
+    REQUIRE(results.name(1) == "ramp");
+
+    auto const &enable_fwd = results.forward(0);
+    REQUIRE(enable_fwd.polls.total() == 2);
+    REQUIRE(enable_fwd.polls[1] == 2);
+    REQUIRE(enable_fwd.ticks[0] == 2);
+
+    auto const &ramp_fwd = results.forward(1);
+    REQUIRE(ramp_fwd.polls.total() == 2);
+    REQUIRE(ramp_fwd.polls[2] == 1); // 3 polls
+    REQUIRE(ramp_fwd.polls[3] == 1); // 6 polls
+    REQUIRE(ramp_fwd.ticks[4] == 1); // 15 ticks
+    REQUIRE(ramp_fwd.ticks[5] == 1); // 30 ticks
+
+    auto const &ramp_bwd = results.backward(1);
+    REQUIRE(ramp_bwd.polls.total() == 1);
+    REQUIRE(ramp_bwd.polls[1] == 1);
+    REQUIRE(ramp_bwd.ticks[7] == 1); // 100 ticks, in the last bucket
+}
+} // namespace
@@ -0,0 +1,224 @@
+#include <seq/builder.hpp>
+#include <seq/parallel_impl.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+namespace {
+std::string result;
+int slow_polls{};
+seq::status fast_back_status = seq::status::DONE;
+
+auto const fast = seq::step(
+    "fast"_sc,
+    []() -> seq::status {
+        result += "Ff";
+        return seq::status::DONE;
+    },
+    []() -> seq::status {
+        result += "Bf";
+        return fast_back_status;
+    });
+
+auto const slow = seq::step(
+    "slow"_sc,
+    []() -> seq::status {
+        result += "Fs";
+        return ++slow_polls < 3 ? seq::status::NOT_DONE : seq::status::DONE;
+    },
+    []() -> seq::status {
+        result += "Bs";
+        return seq::status::DONE;
+    });
+
+auto const last = seq::step(
+    "last"_sc,
+    []() -> seq::status {
+        result += "Fl";
+        return seq::status::DONE;
+    },
+    []() -> seq::status {
+        result += "Bl";
+        return seq::status::DONE;
+    });
+
+auto reset() -> void {
+    result = "";
+    slow_polls = 0;
+    fast_back_status = seq::status::DONE;
+}
+
+TEST_CASE("build and run empty parallel seq", "[parallel_seq]") {
+    seq::parallel_builder<> builder;
+    auto seq_impl = builder.topo_sort<seq::parallel_impl, 0>();
+    REQUIRE(seq_impl.forward() == seq::status::DONE);
+    REQUIRE(seq_impl.backward() == seq::status::DONE);
+}
+
+TEST_CASE("independent steps are polled together", "[parallel_seq]") {
+    reset();
+    seq::parallel_builder<> builder;
+    builder.add((slow && fast) >> last);
+    auto seq_impl = builder.topo_sort<seq::parallel_impl, 3>();
+
+    REQUIRE(seq_impl.forward() == seq::status::NOT_DONE);
+    REQUIRE(result == "FsFf");
+
+    REQUIRE(seq_impl.forward() == seq::status::NOT_DONE);
+    REQUIRE(result == "FsFfFs");
+
+    REQUIRE(seq_impl.forward() == seq::status::DONE);
+    REQUIRE(result == "FsFfFsFsFl");
+
+    REQUIRE(seq_impl.backward() == seq::status::DONE);
+    REQUIRE(result == "FsFfFsFsFlBlBfBs");
+}
+
+TEST_CASE("backward waits for the whole level", "[parallel_seq]") {
+    reset();
+    seq::parallel_builder<> builder;
+    builder.add((slow && fast) >> last);
+    auto seq_impl = builder.topo_sort<seq::parallel_impl, 3>();
+
+    slow_polls = 2;
+    REQUIRE(seq_impl.forward() == seq::status::DONE);
+
+    result = "";
+    fast_back_status = seq::status::NOT_DONE;
+    REQUIRE(seq_impl.backward() == seq::status::NOT_DONE);
+    REQUIRE(result == "BlBfBs");
+
+    fast_back_status = seq::status::DONE;
+    REQUIRE(seq_impl.backward() == seq::status::DONE);
+    REQUIRE(result == "BlBfBsBf");
+}
+
+TEST_CASE("changing direction finishes the level in progress",
+          "[parallel_seq]") {
+    reset();
+    seq::parallel_builder<> builder;
+    builder.add((slow && fast) >> last);
+    auto seq_impl = builder.topo_sort<seq::parallel_impl, 3>();
+
+    REQUIRE(seq_impl.forward() == seq::status::NOT_DONE);
+    REQUIRE(result == "FsFf");
+
+    REQUIRE(seq_impl.backward() == seq::status::NOT_DONE);
+    REQUIRE(result == "FsFfFs");
+
+    REQUIRE(seq_impl.backward() == seq::status::DONE);
+    REQUIRE(result == "FsFfFsFsBfBs");
+}
+
+char stuck{};
+
+template <char Id, typename Name> constexpr auto traced(Name name) {
+    return seq::step(
+        name,
+        []() -> seq::status {
+            result += 'F';
+            result += Id;
+            return seq::status::DONE;
+        },
+        []() -> seq::status {
+            result += 'B';
+            result += Id;
+            return stuck == Id ? seq::status::NOT_DONE : seq::status::DONE;
+        });
+}
+
+constexpr auto root = traced<'r'>("root"_sc);
+constexpr auto left = traced<'l'>("left"_sc);
+constexpr auto right = traced<'R'>("right"_sc);
+constexpr auto leaf = traced<'f'>("leaf"_sc);
+constexpr auto other = traced<'o'>("other"_sc);
+constexpr auto first = traced<'s'>("first"_sc);
+constexpr auto second = traced<'s'>("second"_sc);
+
+constexpr auto tree_builder = [] {
+    seq::parallel_builder<> builder;
+    builder.add(root >> (left && right));
+    builder.add(left >> leaf);
+    builder.add(other);
+    return builder;
+}();
+
+TEST_CASE("rollback sets are worked out at compile time", "[parallel_seq]") {
+    constexpr auto seq_impl =
+        tree_builder.topo_sort<seq::parallel_impl, tree_builder.num_steps()>();
+
+    constexpr auto from_left = seq_impl.rollback_set(seq_impl.index_of(left));
+    static_assert(from_left.size() == 2);
+    static_assert(from_left.contains(seq_impl.index_of(left)));
+    static_assert(from_left.contains(seq_impl.index_of(leaf)));
+
+    constexpr auto from_root = seq_impl.rollback_set(seq_impl.index_of(root));
+    static_assert(from_root.size() == 4);
+    static_assert(not from_root.contains(seq_impl.index_of(other)));
+
+    constexpr auto from_other =
+        seq_impl.rollback_set(seq_impl.index_of(other));
+    static_assert(from_other.size() == 1);
+}
+
+TEST_CASE("steps that share functions keep their own positions",
+          "[parallel_seq]") {
+    constexpr auto shared_builder = [] {
+        seq::parallel_builder<> builder;
+        builder.add(first >> second);
+        return builder;
+    }();
+    constexpr auto seq_impl =
+        shared_builder
+            .topo_sort<seq::parallel_impl, shared_builder.num_steps()>();
+
+    static_assert(seq_impl.index_of(first) == 0);
+    static_assert(seq_impl.index_of(second) == 1);
+    static_assert(seq_impl.rollback_set(seq_impl.index_of(first)).size() == 2);
+    static_assert(seq_impl.rollback_set(seq_impl.index_of(second)).size() ==
+                  1);
+}
+
+TEST_CASE("roll back only what depends on a step", "[parallel_seq]") {
+    reset();
+    stuck = {};
+    auto seq_impl =
+        tree_builder.topo_sort<seq::parallel_impl, tree_builder.num_steps()>();
+    REQUIRE(seq_impl.forward() == seq::status::DONE);
+
+    result = "";
+    REQUIRE(seq_impl.roll_back(left) == seq::status::DONE);
+    REQUIRE(result == "BfBl");
+
+    result = "";
+    REQUIRE(seq_impl.forward() == seq::status::DONE);
+    REQUIRE(result == "FlFf");
+}
+
+TEST_CASE("independent backward steps are polled together",
+          "[parallel_seq]") {
+    reset();
+    stuck = 'f';
+    auto seq_impl =
+        tree_builder.topo_sort<seq::parallel_impl, tree_builder.num_steps()>();
+    REQUIRE(seq_impl.forward() == seq::status::DONE);
+
+    result = "";
+    REQUIRE(seq_impl.roll_back(root) == seq::status::NOT_DONE);
+    REQUIRE(result.find("BR") != std::string::npos);
+    REQUIRE(result.find("Bf") != std::string::npos);
+    REQUIRE(result.find("Bl") == std::string::npos);
+    REQUIRE(result.find("Bo") == std::string::npos);
+
+    result = "";
+    REQUIRE(seq_impl.forward() == seq::status::NOT_DONE);
+    REQUIRE(result == "Bf");
+
+    stuck = {};
+    result = "";
+    REQUIRE(seq_impl.forward() == seq::status::DONE);
+    REQUIRE(result.starts_with("BfBlBr"));
+    REQUIRE(result.find("Fo") == std::string::npos);
+}
+} // namespace
@@ -0,0 +1,147 @@
+#include <seq/builder.hpp>
+#include <seq/timed_impl.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <string>
+
+namespace {
+using namespace std::chrono_literals;
+
+struct manual_clock {
+    using rep = long;
+    using period = std::micro;
+    using duration = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<manual_clock>;
+    constexpr static bool is_steady = true;
+
+    static inline time_point current{};
+
+    static auto now() -> time_point { return current; }
+    static auto advance(duration d) -> void { current += d; }
+};
+
+template <typename Name, std::size_t NumSteps>
+using timed = seq::timed_impl<Name, NumSteps, manual_clock>;
+
+std::string result;
+seq::status hang_status = seq::status::NOT_DONE;
+seq::status undo_status = seq::status::DONE;
+
+auto const a = seq::step(
+    "a"_sc,
+    []() -> seq::status {
+        result += "Fa";
+        return seq::status::DONE;
+    },
+    []() -> seq::status {
+        result += "Ba";
+        return seq::status::DONE;
+    });
+
+auto const hang = seq::step(
+    "hang"_sc,
+    []() -> seq::status {
+        result += "Fh";
+        manual_clock::advance(40us);
+        return hang_status;
+    },
+    []() -> seq::status {
+        result += "Bh";
+        manual_clock::advance(40us);
+        return undo_status;
+    },
+    100us);
+
+auto const c = seq::step(
+    "c"_sc,
+    []() -> seq::status {
+        result += "Fc";
+        return seq::status::DONE;
+    },
+    []() -> seq::status {
+        result += "Bc";
+        return seq::status::DONE;
+    });
+
+auto reset() -> void {
+    result = "";
+    hang_status = seq::status::NOT_DONE;
+    undo_status = seq::status::DONE;
+}
+
+template <typename Seq> auto run_forward(Seq &s) -> seq::timed_status {
+    auto st = s.forward();
+    while (st == seq::timed_status::NOT_DONE) {
+        st = s.forward();
+    }
+    return st;
+}
+
+TEST_CASE("build and run empty timed seq", "[timed_seq]") {
+    seq::timed_builder<void, manual_clock> builder;
+    auto seq_impl = builder.topo_sort<timed, 0>();
+    REQUIRE(seq_impl.forward() == seq::timed_status::DONE);
+    REQUIRE(not seq_impl.timed_out_step());
+}
+
+TEST_CASE("timed seq without deadlines runs like seq::impl", "[timed_seq]") {
+    reset();
+    hang_status = seq::status::DONE;
+    seq::timed_builder<void, manual_clock> builder;
+    builder.add(a >> hang >> c);
+    auto seq_impl = builder.topo_sort<timed, 3>();
+
+    REQUIRE(seq_impl.forward() == seq::timed_status::DONE);
+    REQUIRE(seq_impl.backward() == seq::timed_status::DONE);
+    REQUIRE(result == "FaFhFcBcBhBa");
+    REQUIRE(not seq_impl.timed_out_step());
+}
+
+TEST_CASE("overrunning step rolls the sequence back", "[timed_seq]") {
+    reset();
+    seq::timed_builder<void, manual_clock> builder;
+    builder.add(a >> hang >> c);
+    auto seq_impl = builder.topo_sort<timed, 3>();
+
+    REQUIRE(seq_impl.forward() == seq::timed_status::NOT_DONE);
+    REQUIRE(seq_impl.forward() == seq::timed_status::NOT_DONE);
+    REQUIRE(seq_impl.forward() == seq::timed_status::TIMED_OUT);
+    REQUIRE(result == "FaFhFhFhBhBa");
+
+    REQUIRE(seq_impl.timed_out_step() == 1);
+    REQUIRE(seq_impl.step_name(*seq_impl.timed_out_step()) == "hang");
+
+    hang_status = seq::status::DONE;
+    result = "";
+    REQUIRE(seq_impl.forward() == seq::timed_status::DONE);
+    REQUIRE(result == "FaFhFc");
+    REQUIRE(not seq_impl.timed_out_step());
+}
+
+TEST_CASE("hung undo is abandoned during rollback", "[timed_seq]") {
+    reset();
+    undo_status = seq::status::NOT_DONE;
+    seq::timed_builder<void, manual_clock> builder;
+    builder.add(a >> hang >> c);
+    auto seq_impl = builder.topo_sort<timed, 3>();
+
+    REQUIRE(run_forward(seq_impl) == seq::timed_status::TIMED_OUT);
+    REQUIRE(result == "FaFhFhFhBhBhBhBa");
+    REQUIRE(seq_impl.timed_out_step() == 1);
+}
+
+TEST_CASE("sequence deadline bounds the whole run", "[timed_seq]") {
+    reset();
+    seq::timed_builder<void, manual_clock> builder;
+    builder.add(a >> c >> hang);
+    auto seq_impl = builder.topo_sort<timed, 3>();
+    seq_impl.set_timeout(50us);
+
+    REQUIRE(seq_impl.forward() == seq::timed_status::NOT_DONE);
+    REQUIRE(seq_impl.forward() == seq::timed_status::TIMED_OUT);
+    REQUIRE(result == "FaFcFhFhBhBcBa");
+    REQUIRE(seq_impl.timed_out_step() == 2);
+}
+} // namespace
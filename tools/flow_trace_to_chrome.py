@@ -0,0 +1,107 @@
+# Convert a flow::trace::sink dump into Chrome trace JSON, which can be
+# opened with chrome://tracing or https://ui.perfetto.dev
+#
+# usage: flow_trace_to_chrome.py <dump file> <json file>
+
+import json
+import struct
+import sys
+
+FLOW_BEGIN = 0
+FLOW_END = 1
+STEP = 2
+
+input_file = sys.argv[1]
+json_file = sys.argv[2]
+
+
+class reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def take(self, fmt):
+        values = struct.unpack_from("<" + fmt, self.data, self.pos)
+        self.pos += struct.calcsize("<" + fmt)
+        return values
+
+    def bytes(self, n):
+        value = self.data[self.pos : self.pos + n]
+        self.pos += n
+        return value
+
+
+with open(input_file, "rb") as f:
+    r = reader(f.read())
+
+if r.bytes(4) != b"CIBT":
+    sys.exit(f"{input_file} is not a flow trace dump")
+
+(version,) = r.take("I")
+if version != 1:
+    sys.exit(f"unsupported flow trace version {version}")
+
+period_num, period_den = r.take("QQ")
+to_us = 1e6 * period_num / period_den
+
+names = {}
+(num_names,) = r.take("I")
+for _ in range(num_names):
+    string_id, length = r.take("II")
+    names[string_id] = r.bytes(length).decode("utf-8", "replace")
+
+
+def name_of(string_id):
+    return names.get(string_id, f"0x{string_id:08x}")
+
+
+records = []
+(num_records,) = r.take("I")
+for _ in range(num_records):
+    timestamp, string_id, thread, kind, _ = r.take("QIHBB")
+    records.append((timestamp * to_us, string_id, thread, kind))
+
+events = []
+open_steps = {}
+
+
+def close_step(thread, ts):
+    step = open_steps.pop(thread, None)
+    if step is not None:
+        start, string_id = step
+        events.append(
+            {
+                "name": name_of(string_id),
+                "cat": "step",
+                "ph": "X",
+                "ts": start,
+                "dur": ts - start,
+                "pid": 0,
+                "tid": thread,
+            }
+        )
+
+
+for ts, string_id, thread, kind in records:
+    close_step(thread, ts)
+    if kind == STEP:
+        open_steps[thread] = (ts, string_id)
+    else:
+        events.append(
+            {
+                "name": name_of(string_id),
+                "cat": "flow",
+                "ph": "B" if kind == FLOW_BEGIN else "E",
+                "ts": ts,
+                "pid": 0,
+                "tid": thread,
+            }
+        )
+
+if records:
+    last_ts = records[-1][0]
+    for thread in list(open_steps):
+        close_step(thread, last_ts)
+
+with open(json_file, "w") as out:
+    json.dump({"traceEvents": events, "displayTimeUnit": "ns"}, out, indent=1)